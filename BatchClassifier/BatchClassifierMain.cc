@@ -0,0 +1,285 @@
+#include "Analysis/FileAnalyser.h"
+
+#include <cstdio>
+
+// Headless batch classifier: same pipeline and models as the plugin, no audio device, no window.
+// Neither the message manager nor any GUI class is created, so it runs on build servers without a display.
+//
+// Usage: AutoEffectBatch [options] <file or folder>...
+//   --jobs N          files analysed in parallel (default: physical cores)
+//   --threads N       libtorch intra-op threads per forward call (default: 1, or all cores with --jobs 1)
+//   --model fp32|int8 classifier variant (default: fp32)
+//   --model-dir DIR   folder holding external classifier.pt / classifier_int8.pt (default: the plugin's one)
+//   --output FILE     JSON Lines results (default: stdout)
+//   --timings FILE    per-stage timings of every file, CSV or JSON by extension
+//   --first-window    classify the first window of each file only
+//   --no-cache        neither read nor write the analysis cache
+
+namespace
+{
+    const char* effectIds[numberOfEffects] = { "dry", "feedbackDelay", "slapbackDelay", "reverb", "chorus", "flanger",
+                                               "phaser", "tremolo", "vibrato", "distortion", "overdrive" };
+
+    struct Options
+    {
+        Array<File> inputs;
+        int numJobs = jmax (1, SystemStats::getNumPhysicalCpus());
+        int numThreads = 0;
+        ModelVariant variant = ModelVariant::Float32;
+        File output, timings;
+        AnalysisSettings settings;
+        bool useCache = true;
+    };
+
+    void printUsage()
+    {
+        std::fprintf (stderr, "Usage: AutoEffectBatch [--jobs N] [--threads N] [--model fp32|int8] [--model-dir DIR]\n"
+                              "                       [--output FILE] [--timings FILE] [--first-window] [--no-cache]\n"
+                              "                       <file or folder>...\n");
+    }
+
+    bool parseArguments (int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            String arg (CharPointer_UTF8 (argv[i]));
+
+            auto nextValue = [&]() -> String
+            {
+                if (arg.containsChar ('='))
+                    return arg.fromFirstOccurrenceOf ("=", false, false);
+                return i + 1 < argc ? String (CharPointer_UTF8 (argv[++i])) : String();
+            };
+
+            auto name = arg.upToFirstOccurrenceOf ("=", false, false);
+
+            if (name == "--jobs")               options.numJobs = nextValue().getIntValue();
+            else if (name == "--threads")       options.numThreads = nextValue().getIntValue();
+            else if (name == "--output")        options.output = File::getCurrentWorkingDirectory().getChildFile (nextValue());
+            else if (name == "--timings")       options.timings = File::getCurrentWorkingDirectory().getChildFile (nextValue());
+            else if (name == "--model-dir")     SharedClassifier::setModelDirectory (File::getCurrentWorkingDirectory().getChildFile (nextValue()));
+            else if (name == "--first-window")  options.settings.windowed = false;
+            else if (name == "--no-cache")      options.useCache = false;
+            else if (name == "--model")
+            {
+                auto model = nextValue();
+                if (model != "fp32" && model != "int8")
+                    return false;
+                options.variant = model == "int8" ? ModelVariant::Int8 : ModelVariant::Float32;
+            }
+            else if (arg.startsWith ("-"))
+            {
+                return false;
+            }
+            else
+            {
+                options.inputs.add (File::getCurrentWorkingDirectory().getChildFile (arg));
+            }
+        }
+
+        return options.numJobs > 0 && options.numThreads >= 0 && !options.inputs.isEmpty();
+    }
+
+    ///Sorted, so that two runs over the same folders write their results in a comparable order
+    Array<File> collectFiles (const Array<File>& inputs, const String& wildcard)
+    {
+        Array<File> files;
+
+        for (auto& input : inputs)
+        {
+            if (input.isDirectory())
+            {
+                for (auto& entry : RangedDirectoryIterator (input, true, wildcard, File::findFiles))
+                    files.add (entry.getFile());
+            }
+            else if (input.existsAsFile())
+            {
+                files.add (input);
+            }
+            else
+            {
+                std::fprintf (stderr, "Skipping %s: not found\n", input.getFullPathName().toRawUTF8());
+            }
+        }
+
+        files.sort();
+        return files;
+    }
+
+    String toJSONLine (const File& file, bool succeeded, const AnalysisResult& result, const AnalysisTimingRecord& timings)
+    {
+        DynamicObject::Ptr line (new DynamicObject());
+        line->setProperty ("file", file.getFullPathName());
+        line->setProperty ("ok", succeeded);
+
+        if (succeeded)
+        {
+            line->setProperty ("effect", effectIds[jlimit (0, numberOfEffects - 1, (int) result.effect)]);
+            line->setProperty ("numWindows", result.numWindows);
+            line->setProperty ("fromCache", timings.fromCache);
+
+            Array<var> scores;
+            for (auto score : result.classScores)
+                scores.add (score);
+            line->setProperty ("scores", scores);
+        }
+
+        line->setProperty ("audioSeconds", timings.audioSeconds);
+        line->setProperty ("latencyMs", timings.totalMs);
+
+        return JSON::toString (var (line.get()), true);
+    }
+
+    double percentile (const std::vector<double>& sortedValues, double fraction)
+    {
+        if (sortedValues.empty())
+            return 0.0;
+
+        return sortedValues[(size_t) std::round (fraction * (double) (sortedValues.size() - 1))];
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    Options options;
+
+    if (!parseArguments (argc, argv, options))
+    {
+        printUsage();
+        return 1;
+    }
+
+    if (options.variant == ModelVariant::Int8 && !SharedClassifier::isVariantAvailable (ModelVariant::Int8))
+    {
+        std::fprintf (stderr, "No int8 classifier embedded or in the model folder, using fp32\n");
+        options.variant = ModelVariant::Float32;
+    }
+
+    SharedClassifier::Ptr model;
+
+    try
+    {
+        model = SharedClassifier::acquire (options.variant, options.settings.windowLength);
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf (stderr, "Could not load the classifier: %s\n", e.what());
+        return 1;
+    }
+
+    ///Several workers share the model, each forward call gets its own threads rather than waiting for the others
+    auto numThreads = options.numThreads > 0 ? options.numThreads
+                    : options.numJobs == 1   ? jmax (1, SystemStats::getNumPhysicalCpus())
+                                             : 1;
+    model->setNumInferenceThreads (numThreads);
+    model->setSerialiseForwardCalls (options.numJobs == 1);
+
+    AnalysisCacheSettings cacheSettings;
+    cacheSettings.enabled = options.useCache;
+
+    OwnedArray<FileAnalyser> analysers;
+    for (int i = 0; i < options.numJobs; ++i)
+        analysers.add (new FileAnalyser())->setCacheSettings (cacheSettings);
+
+    auto files = collectFiles (options.inputs, analysers[0]->getSupportedWildcard());
+
+    std::unique_ptr<FileOutputStream> outputFile;
+    if (options.output != File())
+    {
+        options.output.deleteFile();
+        outputFile = options.output.createOutputStream();
+
+        if (outputFile == nullptr)
+        {
+            std::fprintf (stderr, "Could not write to %s\n", options.output.getFullPathName().toRawUTF8());
+            return 1;
+        }
+    }
+
+    auto modelSource = model->getSourceFile() != File() ? model->getSourceFile().getFullPathName() : String ("embedded");
+
+    std::fprintf (stderr, "%d files, %d workers, %d intra-op threads, %s model (%s, %s backend)\n", files.size(), options.numJobs,
+                  numThreads, SharedClassifier::getVariantName (options.variant).toRawUTF8(), modelSource.toRawUTF8(),
+                  model->getBackendName().toRawUTF8());
+
+    std::vector<AnalysisTimingRecord> records ((size_t) files.size());
+    std::atomic<int> nextFile { 0 };
+    std::atomic<int> numFailed { 0 };
+    CriticalSection outputLock;
+
+    auto startTime = Time::getMillisecondCounterHiRes();
+
+    {
+        ThreadPool pool (options.numJobs);
+
+        for (auto* analyser : analysers)
+        {
+            pool.addJob ([&, analyser]
+            {
+                for (int index = nextFile++; index < files.size(); index = nextFile++)
+                {
+                    auto& file = files.getReference (index);
+                    auto& timings = records[(size_t) index];
+                    timings.jobId = index;
+                    timings.fileName = file.getFullPathName();
+                    timings.modelVariant = SharedClassifier::getVariantName (options.variant);
+                    timings.startTimeMs = Time::currentTimeMillis();
+
+                    AnalysisResult result;
+                    auto fileStart = Time::getMillisecondCounterHiRes();
+                    timings.succeeded = analyser->analyse (file, *model, options.settings, result, &timings);
+                    timings.totalMs = Time::getMillisecondCounterHiRes() - fileStart;
+                    timings.numWindows = result.numWindows;
+
+                    if (!timings.succeeded)
+                        ++numFailed;
+
+                    auto line = toJSONLine (file, timings.succeeded, result, timings);
+
+                    const ScopedLock sl (outputLock);
+                    if (outputFile != nullptr)
+                        *outputFile << line << "\n";
+                    else
+                        std::printf ("%s\n", line.toRawUTF8());
+                }
+            });
+        }
+
+        ///The pool destructor would stop the jobs, wait for them instead
+        while (pool.getNumJobs() > 0)
+            Thread::sleep (20);
+    }
+
+    auto wallSeconds = (Time::getMillisecondCounterHiRes() - startTime) * 0.001;
+
+    if (outputFile != nullptr)
+        outputFile->flush();
+    std::fflush (stdout);
+
+    if (options.timings != File() && !options.timings.replaceWithText (options.timings.hasFileExtension ("json")
+                                                                         ? AnalysisTimingRecord::toJSON (records)
+                                                                         : AnalysisTimingRecord::toCSV (records)))
+        std::fprintf (stderr, "Could not write timings to %s\n", options.timings.getFullPathName().toRawUTF8());
+
+    std::vector<double> latencies;
+    double audioSeconds = 0.0;
+    int numFromCache = 0;
+
+    for (auto& record : records)
+    {
+        latencies.push_back (record.totalMs);
+        audioSeconds += record.audioSeconds;
+        numFromCache += record.fromCache ? 1 : 0;
+    }
+
+    std::sort (latencies.begin(), latencies.end());
+
+    std::fprintf (stderr, "%d classified, %d failed, %d from cache\n", files.size() - numFailed.load(), numFailed.load(), numFromCache);
+    std::fprintf (stderr, "%.2f s, %.2f files/s, %.1fx realtime\n", wallSeconds,
+                  (double) files.size() / jmax (1.0e-9, wallSeconds), audioSeconds / jmax (1.0e-9, wallSeconds));
+    std::fprintf (stderr, "latency ms: p50 %.1f  p90 %.1f  p95 %.1f  p99 %.1f  max %.1f\n",
+                  percentile (latencies, 0.5), percentile (latencies, 0.9), percentile (latencies, 0.95),
+                  percentile (latencies, 0.99), latencies.empty() ? 0.0 : latencies.back());
+
+    return numFailed > 0 ? 2 : 0;
+}
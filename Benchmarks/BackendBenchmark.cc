@@ -0,0 +1,169 @@
+#include "Benchmark.h"
+
+#include "Analysis/SharedClassifier.h"
+#include "Analysis/CompactBackend.h"
+#include "Analysis/ResidentMemory.h"
+
+// Per-inference latency of the inference backends, one window and one batch of 8 overlapping windows.
+// libtorch runs the embedded classifier. The compact backend runs the model given in
+// AUTOEFFECT_BENCH_COMPACT_MODEL, or synthetic networks of the size we'd ship (random weights don't
+// change the cost). Binary size and host scan time need two builds, see Scripts/compare_backends.sh.
+
+namespace
+{
+    constexpr int windowLength = 44100;
+    constexpr int hopLength = 22050;
+    constexpr int batchSize = 8;
+
+    void appendUInt32 (MemoryOutputStream& out, uint32 value) { out.writeInt ((int) value); }
+
+    void appendRandomFloats (MemoryOutputStream& out, Random& random, int64 num, float scale)
+    {
+        for (int64 i = 0; i < num; ++i)
+            out.writeFloat ((random.nextFloat() * 2.f - 1.f) * scale);
+    }
+
+    void appendConv (MemoryOutputStream& out, Random& random, int in, int outChannels, int kernel, int stride)
+    {
+        for (auto value : { (uint32) CompactBackend::Conv1d, (uint32) in, (uint32) outChannels, (uint32) kernel, (uint32) stride })
+            appendUInt32 (out, value);
+
+        appendRandomFloats (out, random, (int64) outChannels * kernel * in, 1.f / std::sqrt ((float) (kernel * in)));
+        appendRandomFloats (out, random, outChannels, 0.1f);
+    }
+
+    void appendLayer (MemoryOutputStream& out, CompactBackend::LayerType type)
+    {
+        for (auto value : { (uint32) type, 0u, 0u, 0u, 0u })
+            appendUInt32 (out, value);
+    }
+
+    void appendLinear (MemoryOutputStream& out, Random& random, int in, int outFeatures)
+    {
+        for (auto value : { (uint32) CompactBackend::Linear, (uint32) in, (uint32) outFeatures, 0u, 0u })
+            appendUInt32 (out, value);
+
+        appendRandomFloats (out, random, (int64) outFeatures * in, 1.f / std::sqrt ((float) in));
+        appendRandomFloats (out, random, outFeatures, 0.1f);
+    }
+
+    MemoryBlock makeNetwork (bool logMel)
+    {
+        MemoryOutputStream out;
+        Random random (7);
+
+        String metadata = logMel ? "{\"formatVersion\": 1, \"numClasses\": 11, \"input\": \"logmel\"}"
+                                 : "{\"formatVersion\": 1, \"numClasses\": 11}";
+        auto metadataSize = (int) metadata.getNumBytesAsUTF8();
+
+        out.write ("AENT", 4);
+        appendUInt32 (out, CompactBackend::fileFormatVersion);
+        appendUInt32 (out, (uint32) metadataSize);
+        out.write (metadata.toRawUTF8(), (size_t) metadataSize);
+        out.writeRepeatedByte (0, (size_t) ((4 - metadataSize % 4) % 4));
+
+        appendUInt32 (out, 8);
+
+        if (logMel)
+        {
+            ///[169 frames, 64 mels]
+            appendConv (out, random, 64, 64, 3, 1);
+            appendLayer (out, CompactBackend::ReLU);
+            appendConv (out, random, 64, 64, 3, 2);
+        }
+        else
+        {
+            ///Learnt filterbank over the raw samples, then the same body
+            appendConv (out, random, 1, 64, 1024, 256);
+            appendLayer (out, CompactBackend::ReLU);
+            appendConv (out, random, 64, 64, 3, 2);
+        }
+
+        appendLayer (out, CompactBackend::ReLU);
+        appendConv (out, random, 64, 64, 3, 2);
+        appendLayer (out, CompactBackend::ReLU);
+        appendLayer (out, CompactBackend::MeanPool);
+        appendLinear (out, random, 64, 11);
+
+        return out.getMemoryBlock();
+    }
+
+    void measure (const std::string& name, ClassifierInput input, const std::function<void (const ClassifierInput&)>& forward)
+    {
+        input.numRows = 1;
+        reportMetric (name, "one window", measureSecondsPerCall ([&] { forward (input); }, 20) * 1000.0, "ms");
+
+        input.numRows = batchSize;
+        reportMetric (name, "batch of 8", measureSecondsPerCall ([&] { forward (input); }, 5) * 1000.0, "ms");
+    }
+}
+
+BENCHMARK(Backends)
+{
+    Random random (42);
+    std::vector<float> signal ((size_t) ((batchSize - 1) * hopLength + windowLength));
+    for (auto& sample : signal)
+        sample = random.nextFloat() * 0.5f - 0.25f;
+
+    ClassifierInput waveform;
+    waveform.data = signal.data();
+    waveform.numFrames = windowLength;
+    waveform.rowStride = hopLength;
+
+    std::vector<float> output;
+
+    if (SharedClassifier::isVariantAvailable (ModelVariant::Float32))
+    {
+        auto model = SharedClassifier::acquire (ModelVariant::Float32, windowLength);
+        model->setNumInferenceThreads (1);
+
+        auto name = ("embedded model, " + model->getBackendName()).toStdString();
+        reportMetric (name, "load", model->getLoadMs(), "ms");
+        measure (name, waveform, [&] (const ClassifierInput& input) { model->forward (input, output); doNotOptimise (output); });
+    }
+
+    auto external = SystemStats::getEnvironmentVariable ("AUTOEFFECT_BENCH_COMPACT_MODEL", {});
+
+    if (external.isNotEmpty())
+    {
+        MemoryBlock data;
+        File (external).loadFileAsData (data);
+
+        CompactBackend backend (static_cast<const char*> (data.getData()), data.getSize());
+        reportMetric ("compact " + File (external).getFileName().toStdString(), "parameters", (double) backend.getNumParameters(), "");
+        measure ("compact " + File (external).getFileName().toStdString(), waveform,
+                 [&] (const ClassifierInput& input) { backend.forward (input, output, 1); doNotOptimise (output); });
+    }
+
+    for (auto logMel : { false, true })
+    {
+        auto network = makeNetwork (logMel);
+        auto memoryBefore = getResidentMemoryBytes();
+        CompactBackend backend (static_cast<const char*> (network.getData()), network.getSize());
+
+        std::string name = logMel ? "compact synthetic log-mel" : "compact synthetic waveform";
+        reportMetric (name, "parameters", (double) backend.getNumParameters(), "");
+        reportMetric (name, "resident memory", (double) (getResidentMemoryBytes() - memoryBefore) / (1024.0 * 1024.0), "MB");
+
+        if (!logMel)
+        {
+            measure (name, waveform, [&] (const ClassifierInput& input) { backend.forward (input, output, 1); doNotOptimise (output); });
+            continue;
+        }
+
+        ///Frames of every window of the batch, hop of 22050 samples is 86 frames of 256
+        LogMelSettings settings;
+        LogMelSpectrogram spectrogram (settings);
+        std::vector<float> frames ((size_t) spectrogram.getNumFrames ((int) signal.size()) * (size_t) settings.numMels);
+        spectrogram.process (signal.data(), (int) signal.size(), frames.data());
+
+        ClassifierInput melInput;
+        melInput.data = frames.data();
+        melInput.isSpectrogram = true;
+        melInput.numFrames = spectrogram.getNumFrames (windowLength);
+        melInput.numChannels = settings.numMels;
+        melInput.rowStride = (int64) (hopLength / settings.hopLength) * settings.numMels;
+
+        measure (name, melInput, [&] (const ClassifierInput& input) { backend.forward (input, output, 1); doNotOptimise (output); });
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Tiny benchmark harness: BENCHMARK(Name) registers a function run by BenchmarkMain.cc.
+// Results are printed as "name  metric  value  unit" lines so they can be diffed between builds.
+
+struct BenchmarkCase
+{
+    const char* name;
+    std::function<void()> run;
+};
+
+inline std::vector<BenchmarkCase>& getBenchmarkCases()
+{
+    static std::vector<BenchmarkCase> cases;
+    return cases;
+}
+
+struct BenchmarkRegistration
+{
+    BenchmarkRegistration (const char* name, std::function<void()> run)
+    {
+        getBenchmarkCases().push_back ({ name, std::move (run) });
+    }
+};
+
+#define BENCHMARK(name) \
+    static void name##Benchmark(); \
+    static BenchmarkRegistration name##Registration (#name, name##Benchmark); \
+    static void name##Benchmark()
+
+// Keeps the optimiser from discarding a result
+template <typename T>
+inline void doNotOptimise (const T& value)
+{
+    static volatile const void* sink;
+    sink = &value;
+}
+
+// Best of 'repetitions' runs of 'iterations' calls, in seconds per call. Best-of filters out scheduling noise.
+template <typename Function>
+double measureSecondsPerCall (Function&& function, int iterations, int repetitions = 5)
+{
+    function(); // warm caches and lazy tables
+
+    double best = 1.0e30;
+
+    for (int r = 0; r < repetitions; ++r)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < iterations; ++i)
+            function();
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min (best, elapsed.count() / iterations);
+    }
+
+    return best;
+}
+
+inline void reportMetric (const std::string& name, const char* metric, double value, const char* unit)
+{
+    std::printf ("%-40s %-24s %14.3f %s\n", name.c_str(), metric, value, unit);
+}
@@ -0,0 +1,28 @@
+#include "Benchmark.h"
+
+#include "CustomJuceHeader.h"
+
+// Usage: Benchmarks [substring]   runs every benchmark whose name contains substring
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    std::string filter = argc > 1 ? argv[1] : "";
+    int numRun = 0;
+
+    for (auto& benchmark : getBenchmarkCases())
+    {
+        if (!filter.empty() && std::string (benchmark.name).find (filter) == std::string::npos)
+            continue;
+
+        std::printf ("== %s\n", benchmark.name);
+        benchmark.run();
+        ++numRun;
+    }
+
+   #if JUCE_DEBUG
+    std::printf ("Warning: debug build, timings are not representative\n");
+   #endif
+
+    return numRun > 0 ? 0 : 1;
+}
@@ -0,0 +1,57 @@
+#include "Benchmark.h"
+
+#include "ProcessingChain.h"
+
+// CPU per block of the two chain engines on the same effects: the AudioProcessorGraph the plugin
+// used to run, and the flat in-place chain. Small blocks show the fixed cost of each engine,
+// which is what grows with the number of effects besides the effects themselves.
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int numChannels = 2;
+
+    double measureMicrosecondsPerBlock (ProcessingChain& chain, int blockSize)
+    {
+        AudioBuffer<float> buffer (numChannels, blockSize);
+        MidiBuffer midi;
+        Random random (7);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < blockSize; ++i)
+                buffer.setSample (channel, i, random.nextFloat() * 0.5f - 0.25f);
+
+        ///Every call processes the output of the previous one, like consecutive host blocks
+        return 1.0e6 * measureSecondsPerCall ([&]
+        {
+            ScopedNoDenormals noDenormals;
+            chain.process (buffer, midi);
+            doNotOptimise (buffer.getSample (0, 0));
+        }, 20000 / jmax (1, blockSize / 64));
+    }
+}
+
+BENCHMARK(ChainEngines)
+{
+    for (auto blockSize : { 64, 512 })
+    {
+        for (auto numEffects : { 1, 2, 4, 8, 16 })
+        {
+            Array<EffectEnum> effects;
+            for (int i = 0; i < numEffects; ++i)
+                effects.add (EffectEnum::Chorus);
+
+            ProcessingChain graphChain (effects, numChannels, sampleRate, blockSize, ProcessingChain::Engine::graph);
+            ProcessingChain flatChain (effects, numChannels, sampleRate, blockSize, ProcessingChain::Engine::flat);
+
+            auto graphMicroseconds = measureMicrosecondsPerBlock (graphChain, blockSize);
+            auto flatMicroseconds = measureMicrosecondsPerBlock (flatChain, blockSize);
+
+            auto name = String (numEffects) + " effects, " + String (blockSize) + " samples";
+            reportMetric ((name + " graph").toStdString(), "per block", graphMicroseconds, "us");
+            reportMetric ((name + " flat").toStdString(), "per block", flatMicroseconds, "us");
+            reportMetric (name.toStdString(), "graph overhead", graphMicroseconds - flatMicroseconds, "us");
+            reportMetric (name.toStdString(), "speed-up", graphMicroseconds / jmax (1.0e-9, flatMicroseconds), "x");
+        }
+    }
+}
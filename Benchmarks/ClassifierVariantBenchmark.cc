@@ -0,0 +1,167 @@
+#include "Benchmark.h"
+
+#include "Analysis/WindowedClassifier.h"
+#include "Analysis/ModelInputReader.h"
+#include "Analysis/ResidentMemory.h"
+
+// fp32 against int8 classifier: load cost, resident memory, latency per clip and top-1 agreement.
+// Clips are read from the folder given in AUTOEFFECT_BENCH_CORPUS. Without it a fixed set of synthetic
+// clips is used, good enough for latency and memory but not for judging agreement.
+
+namespace
+{
+    constexpr double modelRate = 22050.0;
+    constexpr int maxClipSeconds = 30;
+
+    struct Clip
+    {
+        String name;
+        std::vector<float> samples; // mono, at the model rate
+    };
+
+    std::vector<Clip> loadCorpusFolder (const File& folder)
+    {
+        AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+        ModelInputReader input;
+
+        auto files = folder.findChildFiles (File::findFiles, true, "*.wav;*.aif;*.aiff;*.flac;*.mp3");
+        files.sort();
+
+        std::vector<Clip> clips;
+
+        for (auto& file : files)
+        {
+            std::unique_ptr<AudioFormatReader> reader (formatManager.createReaderFor (file));
+            if (reader == nullptr)
+                continue;
+
+            Clip clip { file.getFileName(), {} };
+            input.reset (*reader, modelRate);
+
+            std::vector<float> block ((size_t) input.getMaxBlockSize());
+            int numSamples = 0;
+
+            while (clip.samples.size() < (size_t) (modelRate * maxClipSeconds) && input.readNextBlock (block.data(), numSamples))
+                clip.samples.insert (clip.samples.end(), block.begin(), block.begin() + numSamples);
+
+            clips.push_back (std::move (clip));
+        }
+
+        return clips;
+    }
+
+    // Same clips on every run: harmonic tones with noise, amplitude and pitch modulation
+    std::vector<Clip> makeSyntheticCorpus()
+    {
+        std::vector<Clip> clips;
+
+        for (int i = 0; i < 16; ++i)
+        {
+            Random random (1234 + i);
+            Clip clip { "synthetic_" + String (i), std::vector<float> ((size_t) (modelRate * 4)) };
+
+            auto pitch = 80.0 + random.nextDouble() * 800.0;
+            auto modRate = 0.5 + random.nextDouble() * 6.0;
+            auto modDepth = random.nextDouble() * 0.8;
+            auto noise = random.nextFloat() * 0.2f;
+            double phase = 0.0;
+
+            for (size_t n = 0; n < clip.samples.size(); ++n)
+            {
+                auto t = (double) n / modelRate;
+                auto mod = std::sin (MathConstants<double>::twoPi * modRate * t);
+                phase += MathConstants<double>::twoPi * pitch * (1.0 + 0.01 * modDepth * mod) / modelRate;
+
+                auto tone = std::sin (phase) + 0.5 * std::sin (2.0 * phase) + 0.25 * std::sin (3.0 * phase);
+                clip.samples[n] = (float) (0.3 * tone * (1.0 - modDepth * 0.5 * (1.0 + mod))) + noise * (random.nextFloat() * 2.f - 1.f);
+            }
+
+            clips.push_back (std::move (clip));
+        }
+
+        return clips;
+    }
+
+    double percentile (std::vector<double> values, double fraction)
+    {
+        if (values.empty())
+            return 0.0;
+
+        std::sort (values.begin(), values.end());
+        auto index = (size_t) std::round (fraction * (double) (values.size() - 1));
+        return values[index];
+    }
+}
+
+BENCHMARK(ClassifierVariants)
+{
+    auto corpusFolder = SystemStats::getEnvironmentVariable ("AUTOEFFECT_BENCH_CORPUS", {});
+    auto clips = corpusFolder.isNotEmpty() ? loadCorpusFolder (File (corpusFolder)) : makeSyntheticCorpus();
+
+    std::printf ("%d clips from %s\n", (int) clips.size(), corpusFolder.isNotEmpty() ? corpusFolder.toRawUTF8() : "the synthetic corpus");
+
+    if (!SharedClassifier::isVariantAvailable (ModelVariant::Int8))
+        std::printf ("int8 classifier not embedded, run Scripts/quantize_classifier.py and rebuild\n");
+
+    AnalysisSettings settings;
+    auto numThreads = InferenceThreadSettings().getNumIntraOpThreads();
+
+    // Both models stay loaded until the end so the second memory delta doesn't include the first one being freed
+    std::vector<SharedClassifier::Ptr> models;
+    std::vector<std::vector<int>> predictions;
+
+    for (auto variant : { ModelVariant::Float32, ModelVariant::Int8 })
+    {
+        if (!SharedClassifier::isVariantAvailable (variant))
+            continue;
+
+        auto name = ("classifier " + SharedClassifier::getVariantName (variant)).toStdString();
+        auto memoryBefore = getResidentMemoryBytes();
+
+        auto model = SharedClassifier::acquire (variant, settings.windowLength);
+        model->setNumInferenceThreads (numThreads);
+
+        reportMetric (name, "load", model->getLoadMs(), "ms");
+        reportMetric (name, "warm-up", model->getWarmUpMs(), "ms");
+        reportMetric (name, "resident memory", (double) (getResidentMemoryBytes() - memoryBefore) / (1024.0 * 1024.0), "MB");
+
+        WindowedClassifier classifier;
+        std::vector<double> latencies;
+        std::vector<int> classes;
+        double audioSeconds = 0.0, processingSeconds = 0.0;
+
+        for (auto& clip : clips)
+        {
+            auto start = std::chrono::steady_clock::now();
+            auto result = classifier.classify (*model, clip.samples.data(), (int) clip.samples.size(), settings);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+            latencies.push_back (elapsed.count() * 1000.0);
+            classes.push_back ((int) result.effect);
+            audioSeconds += (double) clip.samples.size() / modelRate;
+            processingSeconds += elapsed.count();
+        }
+
+        reportMetric (name, "latency p50", percentile (latencies, 0.5), "ms/clip");
+        reportMetric (name, "latency p95", percentile (latencies, 0.95), "ms/clip");
+        reportMetric (name, "realtime factor", audioSeconds / jmax (1.0e-9, processingSeconds), "x");
+
+        models.push_back (model);
+        predictions.push_back (std::move (classes));
+    }
+
+    if (predictions.size() == 2 && !clips.empty())
+    {
+        int numAgreeing = 0;
+        for (size_t i = 0; i < clips.size(); ++i)
+        {
+            if (predictions[0][i] == predictions[1][i])
+                ++numAgreeing;
+            else
+                std::printf ("  %s: fp32 %d, int8 %d\n", clips[i].name.toRawUTF8(), predictions[0][i], predictions[1][i]);
+        }
+
+        reportMetric ("classifier int8", "top-1 agreement", 100.0 * numAgreeing / (double) clips.size(), "%");
+    }
+}
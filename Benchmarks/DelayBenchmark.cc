@@ -0,0 +1,103 @@
+#include "Benchmark.h"
+
+#include "EffectProcessors.h"
+
+// Cost per stereo sample of the delay effects at the usual session rates, against a textbook
+// per-channel dsp::DelayLine with the same feedback and damping. The delay time glides for the
+// whole run, so the smoothed and interpolated read is what gets measured.
+
+namespace
+{
+    constexpr int blockSize = 512;
+
+    void fillNoise (AudioBuffer<float>& buffer)
+    {
+        Random random (11);
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (channel, i, random.nextFloat() * 0.5f - 0.25f);
+    }
+
+    double measureNanosecondsPerSample (std::function<void (AudioBuffer<float>&)> processBlock)
+    {
+        AudioBuffer<float> buffer (2, blockSize);
+        fillNoise (buffer);
+
+        return 1.0e9 / blockSize * measureSecondsPerCall ([&]
+        {
+            ScopedNoDenormals noDenormals;
+            processBlock (buffer);
+            doNotOptimise (buffer.getSample (1, blockSize - 1));
+        }, 4000);
+    }
+
+    void measureEffect (DelayProcessor& processor, double sampleRate)
+    {
+        processor.setPlayConfigDetails (2, 2, sampleRate, blockSize);
+        processor.prepareToPlay (sampleRate, blockSize);
+
+        MidiBuffer midi;
+        bool longer = false;
+
+        auto nanoseconds = measureNanosecondsPerSample ([&] (AudioBuffer<float>& buffer)
+        {
+            ///Keeps the smoother busy without leaving the range
+            longer = !longer;
+            processor.setTime (processor.getMaximumTime() * (longer ? 0.5f : 0.45f));
+            processor.processBlock (buffer, midi);
+        });
+
+        reportMetric ((processor.getName() + " " + String (sampleRate / 1000.0, 1) + " kHz").toStdString(),
+                      "per sample", nanoseconds, "ns");
+    }
+
+    void measureReference (double sampleRate)
+    {
+        dsp::DelayLine<float, dsp::DelayLineInterpolationTypes::Linear> delayLine ((int) (2.0 * sampleRate) + 2);
+        delayLine.prepare ({ sampleRate, (uint32) blockSize, 2 });
+
+        SmoothedValue<float> delaySamples;
+        delaySamples.reset (sampleRate, 0.05);
+        delaySamples.setCurrentAndTargetValue ((float) (0.375 * sampleRate));
+
+        float tone[2] = {};
+        bool longer = false;
+
+        auto nanoseconds = measureNanosecondsPerSample ([&] (AudioBuffer<float>& buffer)
+        {
+            longer = !longer;
+            delaySamples.setTargetValue ((float) ((longer ? 1.0 : 0.9) * sampleRate));
+
+            auto* channels = buffer.getArrayOfWritePointers();
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                delayLine.setDelay (delaySamples.getNextValue());
+
+                for (int channel = 0; channel < 2; ++channel)
+                {
+                    auto input = channels[channel][i];
+                    tone[channel] += 0.6f * (delayLine.popSample (channel) - tone[channel]);
+                    delayLine.pushSample (channel, input + 0.45f * tone[channel]);
+                    channels[channel][i] = 0.65f * input + 0.35f * tone[channel];
+                }
+            }
+        });
+
+        reportMetric (("dsp::DelayLine " + String (sampleRate / 1000.0, 1) + " kHz").toStdString(), "per sample", nanoseconds, "ns");
+    }
+}
+
+BENCHMARK(Delays)
+{
+    for (auto sampleRate : { 44100.0, 96000.0, 192000.0 })
+    {
+        FeedBackDelayProcessor feedbackDelay;
+        SlapbackDelayProcessor slapbackDelay;
+
+        measureEffect (feedbackDelay, sampleRate);
+        measureEffect (slapbackDelay, sampleRate);
+        measureReference (sampleRate);
+    }
+}
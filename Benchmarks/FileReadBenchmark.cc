@@ -0,0 +1,115 @@
+#include "Benchmark.h"
+
+#include "Analysis/FileAnalyser.h"
+
+#if JUCE_LINUX
+ #include <fcntl.h>
+ #include <unistd.h>
+#endif
+
+// Streaming against memory mapped reading of uncompressed files, through the same ModelInputReader
+// the analysis uses (decode, downmix and resampling to the model rate). Warm runs read a file already
+// in the page cache; cold runs first ask the kernel to drop it, which is only possible on Linux.
+
+namespace
+{
+    constexpr double modelRate = 22050.0;
+
+    File writeTestFile (AudioFormat& format, int numChannels, int bitsPerSample, double seconds)
+    {
+        auto file = File::getSpecialLocation (File::tempDirectory)
+                        .getChildFile ("AutoEffectReadBenchmark" + format.getFileExtensions()[0]);
+        file.deleteFile();
+
+        const double sampleRate = 44100.0;
+        std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (file.createOutputStream().release(), sampleRate,
+                                                                            (unsigned int) numChannels, bitsPerSample, {}, 0));
+        AudioBuffer<float> block (numChannels, 44100);
+        Random random (42);
+
+        for (int second = 0; second < (int) seconds; ++second)
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < block.getNumSamples(); ++i)
+                    block.setSample (channel, i, random.nextFloat() * 0.5f - 0.25f);
+
+            writer->writeFromAudioSampleBuffer (block, 0, block.getNumSamples());
+        }
+
+        return file;
+    }
+
+    bool dropFromPageCache (const File& file)
+    {
+       #if JUCE_LINUX
+        auto fd = ::open (file.getFullPathName().toRawUTF8(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        ///Pages just written are dirty and can't be dropped before they reach the disk
+        ::fdatasync (fd);
+        auto dropped = ::posix_fadvise (fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+        ::close (fd);
+        return dropped;
+       #else
+        ignoreUnused (file);
+        return false;
+       #endif
+    }
+
+    ///Opens the file and pulls it entirely through the model input reader, in seconds
+    double readWholeFile (FileAnalyser& analyser, ModelInputReader& input, const File& file, std::vector<float>& block)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        auto reader = analyser.createReader (file);
+        input.reset (*reader, modelRate);
+        block.resize ((size_t) input.getMaxBlockSize());
+
+        int numSamples = 0;
+        while (input.readNextBlock (block.data(), numSamples))
+            doNotOptimise (block[0]);
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+
+    void compare (AudioFormat& format, int numChannels, int bitsPerSample)
+    {
+        const double seconds = 120.0;
+        auto file = writeTestFile (format, numChannels, bitsPerSample, seconds);
+        auto label = format.getFormatName() + " " + String (numChannels) + "ch " + String (bitsPerSample) + "bit";
+
+        for (auto mapped : { false, true })
+        {
+            FileAnalyser analyser;
+            analyser.setUseMemoryMapping (mapped);
+            ModelInputReader input;
+            std::vector<float> block;
+
+            auto name = (label + (mapped ? " mapped" : " streamed")).toStdString();
+
+            if (dropFromPageCache (file))
+                reportMetric (name, "cold", seconds / readWholeFile (analyser, input, file, block), "x realtime");
+
+            double best = 1.0e30;
+            for (int r = 0; r < 5; ++r)
+                best = jmin (best, readWholeFile (analyser, input, file, block));
+
+            reportMetric (name, "warm", seconds / best, "x realtime");
+        }
+
+        file.deleteFile();
+    }
+}
+
+BENCHMARK(FileRead)
+{
+    WavAudioFormat wav;
+    AiffAudioFormat aiff;
+
+    compare (wav, 2, 16);
+    compare (wav, 2, 24);
+    compare (wav, 6, 24);
+    compare (aiff, 2, 24);
+}
@@ -0,0 +1,59 @@
+#include "Benchmark.h"
+
+#include "Analysis/LogMelSpectrogram.h"
+
+// Log-mel front end on its own: frames per second and speed against realtime for a mono signal
+// at the model rate, for the common FFT and hop sizes of spectrogram models.
+
+namespace
+{
+    constexpr double modelRate = 22050.0;
+    constexpr int signalSeconds = 30;
+
+    std::vector<float> makeNoise (int numSamples)
+    {
+        std::vector<float> samples ((size_t) numSamples);
+        Random random (42);
+
+        for (auto& sample : samples)
+            sample = random.nextFloat() * 0.5f - 0.25f;
+
+        return samples;
+    }
+}
+
+BENCHMARK(LogMel)
+{
+    auto signal = makeNoise ((int) modelRate * signalSeconds);
+
+    for (auto fftOrder : { 10, 11 })
+    {
+        for (auto numMels : { 64, 128 })
+        {
+            for (auto hop : { 128, 256, 512 })
+            {
+                LogMelSettings settings;
+                settings.sampleRate = modelRate;
+                settings.fftOrder = fftOrder;
+                settings.hopLength = hop;
+                settings.numMels = numMels;
+
+                LogMelSpectrogram logMel (settings);
+                auto numFrames = logMel.getNumFrames ((int) signal.size());
+                std::vector<float> output ((size_t) numFrames * (size_t) numMels);
+
+                auto seconds = measureSecondsPerCall ([&]
+                {
+                    logMel.process (signal.data(), (int) signal.size(), output.data());
+                    doNotOptimise (output[0]);
+                }, 3);
+
+                auto name = "fft " + std::to_string (1 << fftOrder) + " mels " + std::to_string (numMels)
+                          + " hop " + std::to_string (hop);
+
+                reportMetric (name, "frames", numFrames / seconds, "frames/s");
+                reportMetric (name, "speed", signalSeconds / seconds, "x realtime");
+            }
+        }
+    }
+}
@@ -0,0 +1,161 @@
+#include "Benchmark.h"
+
+#include "ProcessingChain.h"
+
+// Cost of the four modulation effects at 48 kHz, then of their 8 LFOs alone (2 channels each):
+// std::sin every sample, one ModulationCore per effect, and the single core a chain shares between
+// them. Last, the four effects in a chain against the same four running their own cores.
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+
+    const Array<EffectEnum> modulationEffects { EffectEnum::Flanger, EffectEnum::Phaser, EffectEnum::Tremolo, EffectEnum::Vibrato };
+    const int numLfos = modulationEffects.size() * ModulationProcessor::numLfos;
+
+    const float lfoRates[] = { 0.25f, 0.4f, 5.f, 5.f };
+
+    double nanosecondsPerSample (double secondsPerBlock)
+    {
+        return 1.0e9 * secondsPerBlock / blockSize;
+    }
+
+    double savingPercent (double cost, double reference)
+    {
+        return 100.0 * (1.0 - cost / reference);
+    }
+
+    template <typename ProcessBlock>
+    double measureSecondsPerBlock (ProcessBlock&& processBlock)
+    {
+        AudioBuffer<float> buffer (2, blockSize);
+        Random random (9);
+
+        return measureSecondsPerCall ([&]
+        {
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    buffer.setSample (channel, i, random.nextFloat() * 0.5f - 0.25f);
+
+            ScopedNoDenormals noDenormals;
+            processBlock (buffer);
+            doNotOptimise (buffer.getSample (1, blockSize - 1));
+        }, 2000);
+    }
+
+    std::unique_ptr<AudioProcessor> createEffect (EffectEnum effect)
+    {
+        auto processor = createEffectProcessor (effect);
+
+        processor->setPlayConfigDetails (2, 2, sampleRate, blockSize);
+        processor->prepareToPlay (sampleRate, blockSize);
+        return processor;
+    }
+}
+
+BENCHMARK(ModulationEffects)
+{
+    ///Input generation alone, subtracted from every effect
+    auto noiseSeconds = measureSecondsPerBlock ([] (AudioBuffer<float>&) {});
+    MidiBuffer midi;
+
+    for (auto effect : modulationEffects)
+    {
+        auto processor = createEffect (effect);
+
+        reportMetric (processor->getName().toStdString(), "per sample", nanosecondsPerSample (measureSecondsPerBlock ([&] (AudioBuffer<float>& buffer)
+        {
+            processor->processBlock (buffer, midi);
+        }) - noiseSeconds), "ns");
+    }
+}
+
+BENCHMARK(ModulationLfos)
+{
+    HeapBlock<float> values ((size_t) (numLfos * blockSize));
+    std::vector<float> phases ((size_t) numLfos);
+
+    auto sineSeconds = measureSecondsPerCall ([&]
+    {
+        for (int lfo = 0; lfo < numLfos; ++lfo)
+        {
+            auto* output = values + lfo * blockSize;
+            auto increment = lfoRates[lfo / ModulationProcessor::numLfos] / (float) sampleRate;
+
+            for (int i = 0; i < blockSize; ++i)
+            {
+                phases[(size_t) lfo] += increment;
+                phases[(size_t) lfo] -= std::floor (phases[(size_t) lfo]);
+                output[i] = std::sin (MathConstants<float>::twoPi * phases[(size_t) lfo]);
+            }
+        }
+
+        doNotOptimise (values[numLfos * blockSize - 1]);
+    }, 5000);
+
+    OwnedArray<ModulationCore> ownCores;
+
+    for (auto rate : lfoRates)
+    {
+        auto* core = ownCores.add (new ModulationCore());
+        core->prepare (sampleRate, blockSize, ModulationProcessor::numLfos);
+
+        for (int channel = 0; channel < ModulationProcessor::numLfos; ++channel)
+            core->addLfo (rate, 0.25f * (float) channel);
+    }
+
+    auto ownCoresSeconds = measureSecondsPerCall ([&]
+    {
+        for (auto* core : ownCores)
+            core->advance (blockSize);
+
+        doNotOptimise (ownCores.getLast()->getValues (1)[blockSize - 1]);
+    }, 5000);
+
+    ModulationCore sharedCore;
+    sharedCore.prepare (sampleRate, blockSize, numLfos);
+
+    for (auto rate : lfoRates)
+        for (int channel = 0; channel < ModulationProcessor::numLfos; ++channel)
+            sharedCore.addLfo (rate, 0.25f * (float) channel);
+
+    auto sharedSeconds = measureSecondsPerCall ([&]
+    {
+        sharedCore.advance (blockSize);
+        doNotOptimise (sharedCore.getValues (numLfos - 1)[blockSize - 1]);
+    }, 5000);
+
+    reportMetric ("8 LFOs, sin per sample", "per sample", nanosecondsPerSample (sineSeconds), "ns");
+    reportMetric ("8 LFOs, core per effect", "per sample", nanosecondsPerSample (ownCoresSeconds), "ns");
+    reportMetric ("8 LFOs, shared core", "per sample", nanosecondsPerSample (sharedSeconds), "ns");
+    reportMetric ("8 LFOs, shared core", "saving vs sin", savingPercent (sharedSeconds, sineSeconds), "%");
+    reportMetric ("8 LFOs, shared core", "saving vs core per effect", savingPercent (sharedSeconds, ownCoresSeconds), "%");
+}
+
+BENCHMARK(ModulationChain)
+{
+    auto noiseSeconds = measureSecondsPerBlock ([] (AudioBuffer<float>&) {});
+    MidiBuffer midi;
+
+    std::vector<std::unique_ptr<AudioProcessor>> separateEffects;
+    for (auto effect : modulationEffects)
+        separateEffects.push_back (createEffect (effect));
+
+    auto separateSeconds = measureSecondsPerBlock ([&] (AudioBuffer<float>& buffer)
+    {
+        for (auto& processor : separateEffects)
+            processor->processBlock (buffer, midi);
+    }) - noiseSeconds;
+
+    ProcessingChain chain (modulationEffects, 2, sampleRate, blockSize);
+
+    auto sharedSeconds = measureSecondsPerBlock ([&] (AudioBuffer<float>& buffer)
+    {
+        chain.process (buffer, midi);
+    }) - noiseSeconds;
+
+    reportMetric ("4 effects, core per effect", "per sample", nanosecondsPerSample (separateSeconds), "ns");
+    reportMetric ("4 effects, shared core", "per sample", nanosecondsPerSample (sharedSeconds), "ns");
+    reportMetric ("4 effects, shared core", "saving", savingPercent (sharedSeconds, separateSeconds), "%");
+}
@@ -0,0 +1,130 @@
+#include "Benchmark.h"
+
+#include "Analysis/PolyphaseResampler.h"
+
+// Polyphase sinc resampler against the LagrangeInterpolator the model front end used before,
+// on the rates the model actually receives (to 22050 Hz).
+
+namespace
+{
+    constexpr double modelRate = 22050.0;
+    constexpr int chunkSize = 16384;
+
+    std::vector<float> makeSine (double frequency, double sampleRate, int numSamples)
+    {
+        std::vector<float> samples ((size_t) numSamples);
+        for (int i = 0; i < numSamples; ++i)
+            samples[(size_t) i] = (float) (0.5 * std::sin (MathConstants<double>::twoPi * frequency * i / sampleRate));
+        return samples;
+    }
+
+    std::vector<float> resampleLagrange (const std::vector<float>& input, double sourceRate)
+    {
+        auto ratio = sourceRate / modelRate;
+        std::vector<float> output ((size_t) (input.size() / ratio));
+
+        LagrangeInterpolator interpolator;
+        interpolator.process (ratio, input.data(), output.data(), (int) output.size() - 1);
+        output.pop_back();
+        return output;
+    }
+
+    std::vector<float> resamplePolyphase (const std::vector<float>& input, double sourceRate)
+    {
+        PolyphaseResampler resampler (sourceRate, modelRate);
+        std::vector<float> output ((size_t) resampler.getMaxNumOutputSamples ((int) input.size()));
+
+        int numOut = 0;
+        for (size_t pos = 0; pos < input.size(); pos += chunkSize)
+        {
+            auto num = (int) std::min<size_t> (chunkSize, input.size() - pos);
+            numOut += resampler.process (input.data() + pos, num, output.data() + numOut);
+        }
+
+        output.resize ((size_t) numOut);
+        return output;
+    }
+
+    double rms (const float* samples, int num)
+    {
+        double sum = 0.0;
+        for (int i = 0; i < num; ++i)
+            sum += (double) samples[i] * samples[i];
+        return std::sqrt (sum / jmax (1, num));
+    }
+
+    // Least-squares fit of a sine at 'frequency', returns fitted power over residual power in dB
+    double sineSnrDb (const std::vector<float>& output, double frequency)
+    {
+        const int margin = 256;
+        const int num = (int) output.size() - 2 * margin;
+        double ss = 0, sc = 0, cc = 0, ys = 0, yc = 0;
+
+        for (int i = 0; i < num; ++i)
+        {
+            auto w = MathConstants<double>::twoPi * frequency * (i + margin) / modelRate;
+            auto s = std::sin (w), c = std::cos (w);
+            double y = output[(size_t) (i + margin)];
+            ss += s * s; sc += s * c; cc += c * c; ys += y * s; yc += y * c;
+        }
+
+        auto det = ss * cc - sc * sc;
+        auto a = (ys * cc - yc * sc) / det;
+        auto b = (yc * ss - ys * sc) / det;
+        double signal = 0, noise = 0;
+
+        for (int i = 0; i < num; ++i)
+        {
+            auto w = MathConstants<double>::twoPi * frequency * (i + margin) / modelRate;
+            auto fit = a * std::sin (w) + b * std::cos (w);
+            auto error = output[(size_t) (i + margin)] - fit;
+            signal += fit * fit;
+            noise += error * error;
+        }
+
+        return 10.0 * std::log10 (signal / jmax (1.0e-30, noise));
+    }
+
+    void runAccuracy (const char* name, std::vector<float> (*resample) (const std::vector<float>&, double), double sourceRate)
+    {
+        auto length = (int) sourceRate * 2;
+        String label = String (name) + " " + String ((int) sourceRate);
+
+        // Passband: a 1 kHz tone should come out unchanged
+        auto passband = resample (makeSine (1000.0, sourceRate, length), sourceRate);
+        reportMetric (label.toStdString(), "1kHz gain", 20.0 * std::log10 (rms (passband.data() + 256, (int) passband.size() - 512) / (0.5 / std::sqrt (2.0))), "dB");
+        reportMetric (label.toStdString(), "1kHz SNR", sineSnrDb (passband, 1000.0), "dB");
+
+        // Stopband: a 15 kHz tone is above the model Nyquist, anything left is aliasing
+        auto alias = resample (makeSine (15000.0, sourceRate, length), sourceRate);
+        reportMetric (label.toStdString(), "15kHz alias level", 20.0 * std::log10 (jmax (1.0e-12, rms (alias.data() + 256, (int) alias.size() - 512)) / (0.5 / std::sqrt (2.0))), "dB");
+    }
+
+    void runThroughput (const char* name, std::vector<float> (*resample) (const std::vector<float>&, double), double sourceRate)
+    {
+        auto input = makeSine (440.0, sourceRate, (int) sourceRate * 10);
+        auto seconds = measureSecondsPerCall ([&] { doNotOptimise (resample (input, sourceRate)); }, 3);
+
+        String label = String (name) + " " + String ((int) sourceRate);
+        reportMetric (label.toStdString(), "throughput", (double) input.size() / seconds * 1.0e-6, "Msamples/s");
+        reportMetric (label.toStdString(), "realtime factor", 10.0 / seconds, "x");
+    }
+}
+
+BENCHMARK(ResamplerAccuracy)
+{
+    for (auto rate : { 44100.0, 48000.0, 96000.0 })
+    {
+        runAccuracy ("lagrange", resampleLagrange, rate);
+        runAccuracy ("polyphase", resamplePolyphase, rate);
+    }
+}
+
+BENCHMARK(ResamplerThroughput)
+{
+    for (auto rate : { 44100.0, 48000.0, 96000.0 })
+    {
+        runThroughput ("lagrange", resampleLagrange, rate);
+        runThroughput ("polyphase", resamplePolyphase, rate);
+    }
+}
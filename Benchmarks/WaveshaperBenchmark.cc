@@ -0,0 +1,98 @@
+#include "Benchmark.h"
+
+#include "EffectProcessors.h"
+
+// CPU, latency and aliasing of both clipping effects for every oversampling factor, at 48 kHz.
+// Aliasing is everything the output holds besides the harmonics of a 5 kHz sine, in dB below the
+// fundamental: the sine sits exactly on an FFT bin, so the harmonics below Nyquist land on known
+// bins and whatever folded back from above lands between them.
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+
+    constexpr int fftOrder = 12;
+    constexpr int fftSize = 1 << fftOrder;
+    constexpr int sineBin = 427;
+
+    double measureSecondsPerBlock (WaveshaperProcessor& processor)
+    {
+        AudioBuffer<float> buffer (2, blockSize);
+        MidiBuffer midi;
+        Random random (3);
+
+        return measureSecondsPerCall ([&]
+        {
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    buffer.setSample (channel, i, random.nextFloat() - 0.5f);
+
+            ScopedNoDenormals noDenormals;
+            processor.processBlock (buffer, midi);
+            doNotOptimise (buffer.getSample (1, blockSize - 1));
+        }, 2000);
+    }
+
+    double measureAliasingDecibels (WaveshaperProcessor& processor)
+    {
+        processor.reset();
+
+        AudioBuffer<float> buffer (2, fftSize);
+        MidiBuffer midi;
+        std::vector<float> spectrum (2 * fftSize);
+
+        ///The input repeats every fftSize samples, the second period is past the filters settling
+        for (int period = 0; period < 2; ++period)
+        {
+            for (int i = 0; i < fftSize; ++i)
+            {
+                auto sample = 0.8f * std::sin (MathConstants<float>::twoPi * (float) sineBin * (float) i / (float) fftSize);
+                buffer.setSample (0, i, sample);
+                buffer.setSample (1, i, sample);
+            }
+
+            for (int start = 0; start < fftSize; start += blockSize)
+            {
+                AudioBuffer<float> block (buffer.getArrayOfWritePointers(), 2, start, blockSize);
+                processor.processBlock (block, midi);
+            }
+        }
+
+        std::copy (buffer.getReadPointer (0), buffer.getReadPointer (0) + fftSize, spectrum.begin());
+        dsp::FFT (fftOrder).performFrequencyOnlyForwardTransform (spectrum.data());
+
+        ///sineBin is prime to fftSize, no folded harmonic can land on the bin of a real one
+        double aliased = 0.0;
+
+        for (int bin = 1; bin < fftSize / 2; ++bin)
+            if (bin % sineBin != 0)
+                aliased += (double) spectrum[(size_t) bin] * spectrum[(size_t) bin];
+
+        auto fundamental = (double) spectrum[sineBin] * spectrum[sineBin];
+        return Decibels::gainToDecibels (std::sqrt (aliased / fundamental), -200.0);
+    }
+
+    template <typename Effect>
+    void benchmarkFactors (const String& name)
+    {
+        for (int factor = 1; factor <= WaveshaperProcessor::maximumOversamplingFactor; factor *= 2)
+        {
+            Effect effect;
+            effect.setPlayConfigDetails (2, 2, sampleRate, blockSize);
+            effect.prepareToPlay (sampleRate, blockSize);
+            effect.setOversamplingFactor (factor);
+
+            auto label = (name + " " + String (factor) + "x").toStdString();
+            reportMetric (label, "per sample", 1.0e9 * measureSecondsPerBlock (effect) / blockSize, "ns");
+            reportMetric (label, "latency", effect.getLatencySamples(), "samples");
+            reportMetric (label, "aliasing", measureAliasingDecibels (effect), "dB");
+        }
+    }
+}
+
+BENCHMARK(OversampledWaveshapers)
+{
+    benchmarkFactors<DistortionProcessor> ("Distortion");
+    benchmarkFactors<OverdriveProcessor> ("Overdrive");
+}
@@ -0,0 +1,59 @@
+#!/bin/sh
+# Builds the plugin with and without libtorch and compares what a host sees:
+#   - size of the plugin binary plus the non-system shared libraries it loads
+#   - time to load the plugin binary in a fresh process, the bulk of a host scan
+#     (libtorch static initialisers run there, before any plugin code)
+#   - per-inference latency of each backend (Benchmarks, "Backends" case)
+#
+# The compact build embeds Ressources/classifier.aenet when it exists.
+# Usage: Scripts/compare_backends.sh [build root, default _backends]
+
+set -e
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+OUT=${1:-"$ROOT/_backends"}
+
+build() {
+    cmake -S "$ROOT" -B "$OUT/$1" -DCMAKE_BUILD_TYPE=Release -DAUTOEFFECT_WITH_LIBTORCH="$2" > /dev/null
+    cmake --build "$OUT/$1" --config Release -j"$(getconf _NPROCESSORS_ONLN)" > /dev/null
+}
+
+plugin_binary() {
+    if [ "$(uname)" = "Darwin" ]; then
+        find "$OUT/$1" -path "*AutoEffect.vst3/Contents/MacOS/AutoEffect" -type f | head -n 1
+    else
+        find "$OUT/$1" -path "*AutoEffect.vst3/Contents/*/AutoEffect.so" -type f | head -n 1
+    fi
+}
+
+# Plugin binary plus the shared libraries it pulls that a host doesn't already have
+loaded_bytes() {
+    if [ "$(uname)" = "Darwin" ]; then
+        libs=$(otool -L "$1" | awk 'NR > 1 { print $1 }' | grep -v -e '^/usr/lib' -e '^/System' | sed "s|@rpath|$ROOT/libtorch/lib|")
+    else
+        libs=$(ldd "$1" | awk '/=>/ { print $3 }' | grep -v -e '^/lib' -e '^/usr/lib')
+    fi
+    # shellcheck disable=SC2086
+    du -cL "$1" $libs 2> /dev/null | tail -n 1 | awk '{ printf "%.1f MB", $1 / 1024 }'
+}
+
+# Best of 5 loads, each in a new process so nothing is already mapped
+load_ms() {
+    python3 - "$1" << 'PY'
+import ctypes, os, subprocess, sys
+code = "import ctypes, os, sys, time; t = time.perf_counter(); ctypes.CDLL(sys.argv[1], os.RTLD_NOW); print((time.perf_counter() - t) * 1000)"
+runs = [float(subprocess.check_output([sys.executable, "-c", code, sys.argv[1]])) for _ in range(5)]
+print(f"{min(runs):.1f} ms")
+PY
+}
+
+build libtorch ON
+build compact OFF
+
+for variant in libtorch compact; do
+    binary=$(plugin_binary "$variant")
+    echo "== $variant backend"
+    echo "plugin and libraries: $(loaded_bytes "$binary")"
+    echo "binary load (scan):   $(load_ms "$binary")"
+    "$OUT/$variant/Benchmarks" Backends
+done
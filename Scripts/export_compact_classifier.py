@@ -0,0 +1,111 @@
+"""Exports a small convolutional classifier to the compact format run by the plugin without libtorch.
+
+The compact backend (Source/Analysis/CompactBackend.h) only knows Conv1d, ReLU, a mean over
+time and Linear layers. The model to export is a TorchScript file or a pickled nn.Module
+whose `layers` attribute (or the module itself) is an nn.Sequential of:
+    Conv1d (no padding, no dilation, groups=1), ReLU, AdaptiveAvgPool1d(1), Flatten, Linear
+taking [batch, channels, time]: the waveform with one channel, or log-mel frames transposed to
+[batch, mels, frames]. The plugin keeps activations as [time, channels], convolution weights are
+written in that order.
+
+Usage: python Scripts/export_compact_classifier.py --input small.pt [--output classifier.aenet] [--logmel]
+Copy the result to Ressources/ for builds without libtorch, or to the AutoEffect/Models folder.
+"""
+
+import argparse
+import json
+import struct
+
+import torch
+
+from package_classifier import FORMAT_VERSION, NUM_CLASSES, SAMPLE_RATE, WINDOW_LENGTH
+
+# Must match CompactBackend::fileFormatVersion and CompactBackend::LayerType
+FILE_FORMAT_VERSION = 1
+CONV1D, RELU, MEAN_POOL, LINEAR = 1, 2, 3, 4
+
+
+def layer_kind(module):
+    # Scripted submodules keep the name of their Python class
+    return getattr(module, "original_name", type(module).__name__)
+
+
+def floats(tensor):
+    values = tensor.detach().to(torch.float32).contiguous().flatten().tolist()
+    return struct.pack(f"<{len(values)}f", *values)
+
+
+def export_layers(sequential):
+    layers = []
+
+    for module in sequential.children():
+        kind = layer_kind(module)
+
+        if kind == "Conv1d":
+            if module.padding not in ((0,), 0) or module.dilation != (1,) or module.groups != 1:
+                raise SystemExit("Conv1d layers must have no padding, no dilation and one group")
+            out_channels, in_channels, kernel_size = module.weight.shape
+            header = struct.pack("<5I", CONV1D, in_channels, out_channels, kernel_size, module.stride[0])
+            # [out][in][k] to the channels-last [out][k][in]
+            layers.append(header + floats(module.weight.permute(0, 2, 1)) + floats(module.bias))
+        elif kind == "Linear":
+            out_features, in_features = module.weight.shape
+            header = struct.pack("<5I", LINEAR, in_features, out_features, 0, 0)
+            layers.append(header + floats(module.weight) + floats(module.bias))
+        elif kind == "ReLU":
+            layers.append(struct.pack("<5I", RELU, 0, 0, 0, 0))
+        elif kind == "AdaptiveAvgPool1d":
+            layers.append(struct.pack("<5I", MEAN_POOL, 0, 0, 0, 0))
+        elif kind == "Flatten":
+            continue
+        else:
+            raise SystemExit(f"{kind} layers are not supported by the compact backend")
+
+    return layers
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--input", required=True)
+    parser.add_argument("--output", default="classifier.aenet")
+    parser.add_argument("--logmel", action="store_true", help="the model takes log-mel frames")
+    parser.add_argument("--fft-size", type=int, default=1024)
+    parser.add_argument("--mel-hop", type=int, default=256)
+    parser.add_argument("--num-mels", type=int, default=64)
+    args = parser.parse_args()
+
+    try:
+        model = torch.jit.load(args.input, map_location="cpu")
+    except RuntimeError:
+        model = torch.load(args.input, map_location="cpu")
+
+    sequential = getattr(model, "layers", model)
+    layers = export_layers(sequential)
+
+    metadata = {
+        "formatVersion": FORMAT_VERSION,
+        "numClasses": NUM_CLASSES,
+        "sampleRate": SAMPLE_RATE,
+        "windowLength": WINDOW_LENGTH,
+        "input": "logmel" if args.logmel else "waveform",
+    }
+
+    if args.logmel:
+        metadata.update({"fftSize": args.fft_size, "melHopLength": args.mel_hop, "numMels": args.num_mels})
+
+    metadata_bytes = json.dumps(metadata).encode("utf-8")
+    padding = b"\0" * (-len(metadata_bytes) % 4)
+
+    with open(args.output, "wb") as output:
+        output.write(b"AENT" + struct.pack("<II", FILE_FORMAT_VERSION, len(metadata_bytes)))
+        output.write(metadata_bytes + padding)
+        output.write(struct.pack("<I", len(layers)))
+        for layer in layers:
+            output.write(layer)
+
+    num_parameters = sum(p.numel() for p in sequential.parameters())
+    print(f"Saved {args.output}: {len(layers)} layers, {num_parameters} parameters")
+
+
+if __name__ == "__main__":
+    main()
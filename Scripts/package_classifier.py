@@ -0,0 +1,68 @@
+"""Writes a classifier the plugin can load at runtime instead of its embedded model.
+
+The TorchScript archive gets an extra autoeffect.json file with the metadata the plugin checks
+before loading it (SharedClassifier::checkModelMetadata). Copy the result to the AutoEffect/Models
+folder of the user application data, as classifier.pt or classifier_int8.pt: running plugin
+instances switch to it before their next analysis, and go back to the embedded model if it is
+rejected or removed. For an int8 model, package the output of quantize_classifier.py.
+
+Usage: python Scripts/package_classifier.py --input trained.pt [--output classifier.pt] [--logmel]
+With --logmel the model takes [windows, frames, mels] log-mel frames computed by the plugin
+(LogMelSpectrogram, torchaudio MelSpectrogram(center=False, mel_scale="htk") then log(x + 1e-6))
+instead of [windows, samples].
+The torch version should match the libtorch the plugin is built against.
+"""
+
+import argparse
+import json
+
+import torch
+
+# Must match SharedClassifier::supportedModelFormatVersion
+FORMAT_VERSION = 1
+NUM_CLASSES = 11
+SAMPLE_RATE = 22050
+WINDOW_LENGTH = 44100
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--input", required=True)
+    parser.add_argument("--output", default="classifier.pt")
+    parser.add_argument("--logmel", action="store_true", help="the model takes log-mel frames")
+    parser.add_argument("--fft-size", type=int, default=1024)
+    parser.add_argument("--mel-hop", type=int, default=256)
+    parser.add_argument("--num-mels", type=int, default=64)
+    args = parser.parse_args()
+
+    if args.logmel:
+        num_frames = 1 + (WINDOW_LENGTH - args.fft_size) // args.mel_hop
+        example = torch.zeros(1, num_frames, args.num_mels)
+    else:
+        example = torch.zeros(1, WINDOW_LENGTH)
+
+    model = torch.jit.load(args.input, map_location="cpu").eval()
+
+    # Same check as the plugin warm-up: one window in, one score per effect out
+    with torch.no_grad():
+        scores = model(example)
+    if scores.numel() != NUM_CLASSES:
+        raise SystemExit(f"{args.input} returns {scores.numel()} scores per window, {NUM_CLASSES} expected")
+
+    metadata = {
+        "formatVersion": FORMAT_VERSION,
+        "numClasses": NUM_CLASSES,
+        "sampleRate": SAMPLE_RATE,
+        "windowLength": WINDOW_LENGTH,
+        "input": "logmel" if args.logmel else "waveform",
+    }
+
+    if args.logmel:
+        metadata.update({"fftSize": args.fft_size, "melHopLength": args.mel_hop, "numMels": args.num_mels})
+
+    torch.jit.save(model, args.output, _extra_files={"autoeffect.json": json.dumps(metadata)})
+    print(f"Saved {args.output}")
+
+
+if __name__ == "__main__":
+    main()
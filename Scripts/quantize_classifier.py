@@ -0,0 +1,33 @@
+"""Builds Ressources/classifier_int8.pt, a dynamic-quantised copy of Ressources/classifier.pt.
+
+Linear and recurrent weights are stored as int8 and activations are quantised on the fly,
+so no calibration data is needed. CMake embeds the result next to the fp32 model when the
+file exists, and the plugin can then switch to it at runtime (setModelVariant).
+
+Usage: python Scripts/quantize_classifier.py [--input Ressources/classifier.pt] [--output Ressources/classifier_int8.pt]
+The torch version should match the libtorch the plugin is built against.
+"""
+
+import argparse
+
+import torch
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--input", default="Ressources/classifier.pt")
+    parser.add_argument("--output", default="Ressources/classifier_int8.pt")
+    args = parser.parse_args()
+
+    model = torch.jit.load(args.input, map_location="cpu").eval()
+    model = torch.jit.freeze(model)
+
+    quantised = torch.quantization.quantize_dynamic_jit(
+        model, {"": torch.quantization.default_dynamic_qconfig})
+
+    quantised.save(args.output)
+    print(f"Saved {args.output}")
+
+
+if __name__ == "__main__":
+    main()
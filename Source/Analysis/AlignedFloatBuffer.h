@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    AlignedFloatBuffer.h
+    Created: 18 Oct 2026 4:55:21pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CustomJuceHeader.h"
+
+//==============================================================================
+/**
+    Float storage starting on a cache line, meant to be kept across analyses.
+
+    It only grows (keeping its content) and never shrinks, so once it has seen
+    the biggest size used, reusing it doesn't touch the heap anymore.
+*/
+class AlignedFloatBuffer
+{
+public:
+    static constexpr size_t alignment = 64;
+
+    AlignedFloatBuffer() = default;
+
+    void ensureSize (size_t numFloats)
+    {
+        if (numFloats <= capacity)
+            return;
+
+        HeapBlock<char> newStorage (numFloats * sizeof (float) + alignment);
+        auto* newData = alignPointer (newStorage.get());
+
+        if (capacity > 0)
+            std::memcpy (newData, aligned, capacity * sizeof (float));
+
+        storage.swapWith (newStorage);
+        aligned = newData;
+        capacity = numFloats;
+    }
+
+    float* data() noexcept               { return aligned; }
+    const float* data() const noexcept   { return aligned; }
+    size_t size() const noexcept         { return capacity; }
+
+private:
+    static float* alignPointer (char* address) noexcept
+    {
+        auto value = (reinterpret_cast<uintptr_t> (address) + alignment - 1) & ~(uintptr_t) (alignment - 1);
+        return reinterpret_cast<float*> (value);
+    }
+
+    HeapBlock<char> storage;
+    float* aligned = nullptr;
+    size_t capacity = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AlignedFloatBuffer)
+};
@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+    AllocationCounter.cpp
+    Created: 18 Oct 2026 4:55:21pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#include "AllocationCounter.h"
+
+#if AUTOEFFECT_COUNT_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    ///Plain integer, no dynamic initialisation, so it is usable from operator new on any thread
+    thread_local int64 threadAllocationCount = 0;
+}
+
+void* operator new (std::size_t size)
+{
+    ++threadAllocationCount;
+
+    if (auto* memory = std::malloc (size > 0 ? size : 1))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size)                 { return operator new (size); }
+void operator delete (void* memory) noexcept            { std::free (memory); }
+void operator delete[] (void* memory) noexcept          { std::free (memory); }
+void operator delete (void* memory, std::size_t) noexcept   { std::free (memory); }
+void operator delete[] (void* memory, std::size_t) noexcept { std::free (memory); }
+
+bool AllocationCounter::isEnabled() noexcept                  { return true; }
+int64 AllocationCounter::getThreadAllocationCount() noexcept  { return threadAllocationCount; }
+
+#else
+
+bool AllocationCounter::isEnabled() noexcept                  { return false; }
+int64 AllocationCounter::getThreadAllocationCount() noexcept  { return 0; }
+
+#endif
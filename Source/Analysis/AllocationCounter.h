@@ -0,0 +1,31 @@
+/*
+  ==============================================================================
+
+    AllocationCounter.h
+    Created: 18 Oct 2026 4:55:21pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CustomJuceHeader.h"
+
+//==============================================================================
+/**
+    Per-thread count of global operator new calls, to check that a code path
+    stops allocating once warmed up.
+
+    Counting replaces the global operator new, which a plugin binary shouldn't
+    do in a release build, so it is only compiled in with the CMake option
+    AUTOEFFECT_COUNT_ALLOCATIONS. Allocations libtorch makes through malloc
+    directly are not seen.
+*/
+namespace AllocationCounter
+{
+    bool isEnabled() noexcept;
+
+    ///Allocations made by the calling thread so far, 0 when counting is disabled
+    int64 getThreadAllocationCount() noexcept;
+}
@@ -0,0 +1,210 @@
+/*
+  ==============================================================================
+
+    AnalysisJobQueue.h
+    Created: 17 Oct 2026 10:12:40am
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "AnalysisTypes.h"
+#include "AnalysisTimings.h"
+
+enum class AnalysisJobStatus {
+    Queued = 0,
+    Running,
+    Succeeded,
+    Failed,
+    Cancelled
+};
+
+class AnalysisJob;
+
+//==============================================================================
+/** What an asynchronous analysis reports, every callback is called on the message thread. */
+struct AnalysisCallbacks
+{
+    ///Result, class probabilities and stage timings are ready in the job
+    std::function<void (const AnalysisJob&)> onComplete;
+
+    ///Fraction of the file decoded so far, from 0 to 1. Calls are coalesced, not every chunk is reported
+    std::function<void (const AnalysisJob&, double progress)> onProgress;
+
+    ///The file couldn't be classified, or the job was cancelled (its status then says Cancelled)
+    std::function<void (const AnalysisJob&, const String& error)> onError;
+};
+
+//==============================================================================
+/**
+    One file waiting to be (or being) classified by the processor worker thread.
+
+    The object is shared between the submitter and the worker, so the status is
+    atomic and can be polled from any thread. The result is only meaningful once
+    the status is Succeeded.
+*/
+class AnalysisJob : public ReferenceCountedObject
+{
+public:
+    using Ptr = ReferenceCountedObjectPtr<AnalysisJob>;
+    using CompletionCallback = std::function<void (const AnalysisJob&)>;
+
+    AnalysisJob (int jobId, const File& fileToAnalyse, CompletionCallback callback)
+        : id (jobId), file (fileToAnalyse), onComplete (std::move (callback))
+    {}
+
+    AnalysisJobStatus getStatus() const { return status.load(); }
+    bool isFinished() const { return getStatus() != AnalysisJobStatus::Queued && getStatus() != AnalysisJobStatus::Running; }
+
+    ///Safe from any thread, a queued job is then skipped and a running one stops at its next check
+    void cancel() { cancellation.cancel(); }
+    bool isCancelled() const { return cancellation.isCancelled(); }
+
+    const int id;
+    const File file;
+
+    ///Called on the worker thread once the job is finished (success, failure or cancellation)
+    CompletionCallback onComplete;
+
+    ///Called on the message thread, set before the job is queued
+    AnalysisCallbacks callbacks;
+
+    AnalysisCancellation cancellation;
+
+    std::atomic<AnalysisJobStatus> status { AnalysisJobStatus::Queued };
+
+    AnalysisResult result;
+
+    ///Why the job failed, empty otherwise
+    String errorMessage;
+
+    ///Fraction of the file decoded so far
+    std::atomic<double> progress { 0.0 };
+
+    ///Set while a progress message is waiting on the message thread, so they don't pile up
+    std::atomic<bool> progressPending { false };
+
+    ///Time spent in processAudioFile for this job, in seconds
+    double processingSeconds = 0.0;
+
+    ///Heap allocations of the worker during processAudioFile, -1 unless built with AUTOEFFECT_COUNT_ALLOCATIONS
+    int64 numAllocations = -1;
+
+    ///Filled by the worker, stage by stage, copied into the processor timing history when the job ends
+    AnalysisTimingRecord timings;
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalysisJob)
+};
+
+//==============================================================================
+/**
+    Bounded multi-producer / multi-consumer queue of AnalysisJob.
+
+    Each slot carries a sequence number telling whether it is ready to be written
+    or read, so push and pop never take a lock and never allocate: dropping files
+    from the message thread can't be blocked by the worker thread.
+*/
+class AnalysisJobQueue
+{
+public:
+    /** The capacity is rounded up to the next power of two. */
+    explicit AnalysisJobQueue (int capacity = 256)
+        : numSlots ((size_t) nextPowerOfTwo (jmax (2, capacity))),
+          mask (numSlots - 1),
+          slots (new Slot[numSlots])
+    {
+        for (size_t i = 0; i < numSlots; ++i)
+            slots[i].sequence.store (i, std::memory_order_relaxed);
+    }
+
+    /** Returns false if the queue is full, the job is then left untouched. */
+    bool push (AnalysisJob::Ptr& job)
+    {
+        auto pos = writePos.load (std::memory_order_relaxed);
+
+        for (;;)
+        {
+            auto& slot = slots[pos & mask];
+            auto seq = slot.sequence.load (std::memory_order_acquire);
+            auto diff = (intptr_t) seq - (intptr_t) pos;
+
+            if (diff == 0)
+            {
+                if (writePos.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+                {
+                    slot.job = std::move (job);
+                    slot.sequence.store (pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = writePos.load (std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /** Returns false if there was nothing to pop. */
+    bool pop (AnalysisJob::Ptr& job)
+    {
+        auto pos = readPos.load (std::memory_order_relaxed);
+
+        for (;;)
+        {
+            auto& slot = slots[pos & mask];
+            auto seq = slot.sequence.load (std::memory_order_acquire);
+            auto diff = (intptr_t) seq - (intptr_t) (pos + 1);
+
+            if (diff == 0)
+            {
+                if (readPos.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+                {
+                    job = std::move (slot.job);
+                    slot.sequence.store (pos + numSlots, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = readPos.load (std::memory_order_relaxed);
+            }
+        }
+    }
+
+    ///Approximate number of jobs waiting, only exact when no push/pop is running
+    int getNumPending() const
+    {
+        auto w = writePos.load (std::memory_order_relaxed);
+        auto r = readPos.load (std::memory_order_relaxed);
+        return w > r ? (int) (w - r) : 0;
+    }
+
+    int getCapacity() const { return (int) numSlots; }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence { 0 };
+        AnalysisJob::Ptr job;
+    };
+
+    const size_t numSlots;
+    const size_t mask;
+    std::unique_ptr<Slot[]> slots;
+
+    alignas (64) std::atomic<size_t> writePos { 0 };
+    alignas (64) std::atomic<size_t> readPos { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalysisJobQueue)
+};
@@ -0,0 +1,389 @@
+/*
+  ==============================================================================
+
+    AnalysisResultCache.cpp
+    Created: 17 Oct 2026 4:52:33pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#include "AnalysisResultCache.h"
+
+namespace
+{
+    constexpr uint64 hashMultiplier1 = 0x87c37b91114253d5ull;
+    constexpr uint64 hashMultiplier2 = 0x4cf5ad432745937full;
+
+    inline uint64 rotateLeft (uint64 x, int r) { return (x << r) | (x >> (64 - r)); }
+
+    ///Bump when the entry layout or what goes in the keys changes
+    constexpr int cacheFormatVersion = 2;
+    constexpr int entryMagic = 0x31434541; // "AEC1"
+
+    ///InterProcessLock is only exclusive between processes, this one covers instances of the same process
+    CriticalSection processLock;
+
+    void addSettingsToKey (ContentHasher& hasher, const String& modelId, const AnalysisSettings& analysisSettings)
+    {
+        hasher.updateValue (cacheFormatVersion);
+        hasher.updateString (modelId);
+        hasher.updateValue (analysisSettings.downmix);
+        hasher.updateValue (analysisSettings.windowed);
+        hasher.updateValue (analysisSettings.windowLength);
+        hasher.updateValue (analysisSettings.hopLength);
+    }
+}
+
+//==============================================================================
+void ContentHasher::mixWord (uint64 word)
+{
+    word *= hashMultiplier1;
+    word = rotateLeft (word, 31);
+    word *= hashMultiplier2;
+
+    state ^= word;
+    state = rotateLeft (state, 27) * 5 + 0x52dce729;
+}
+
+void ContentHasher::update (const void* data, size_t numBytes)
+{
+    auto* bytes = static_cast<const uint8*> (data);
+    totalLength += numBytes;
+
+    ///Complete the word left by the previous call first
+    while (numPending > 0 && numPending < 8 && numBytes > 0)
+    {
+        pending[numPending++] = *bytes++;
+        --numBytes;
+    }
+
+    if (numPending == 8)
+    {
+        uint64 word;
+        memcpy (&word, pending, 8);
+        mixWord (word);
+        numPending = 0;
+    }
+
+    while (numBytes >= 8)
+    {
+        uint64 word;
+        memcpy (&word, bytes, 8);
+        mixWord (word);
+        bytes += 8;
+        numBytes -= 8;
+    }
+
+    while (numBytes > 0)
+    {
+        pending[numPending++] = *bytes++;
+        --numBytes;
+    }
+}
+
+uint64 ContentHasher::getHash() const
+{
+    auto copy = *this;
+
+    if (copy.numPending > 0)
+    {
+        uint64 word = 0;
+        memcpy (&word, copy.pending, copy.numPending);
+        copy.mixWord (word);
+    }
+
+    auto h = copy.state ^ totalLength;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+//==============================================================================
+AnalysisResultCache::AnalysisResultCache (const File& cacheDirectory)
+    : directory (cacheDirectory)
+{
+}
+
+File AnalysisResultCache::getDefaultDirectory()
+{
+    return File::getSpecialLocation (File::userApplicationDataDirectory)
+          #if JUCE_MAC
+           .getChildFile ("Application Support")
+          #endif
+           .getChildFile ("AutoEffect")
+           .getChildFile ("AnalysisCache");
+}
+
+String AnalysisResultCache::makeFileKey (const File& file, const String& modelId, const AnalysisSettings& analysisSettings)
+{
+    ContentHasher hasher;
+    hasher.updateString (file.getFullPathName());
+    hasher.updateValue (file.getSize());
+    hasher.updateValue (file.getLastModificationTime().toMilliseconds());
+    addSettingsToKey (hasher, modelId, analysisSettings);
+
+    return "f" + hasher.toHexString();
+}
+
+String AnalysisResultCache::makeContentKey (const ContentHasher& audioHash, const String& modelId, const AnalysisSettings& analysisSettings)
+{
+    ContentHasher hasher;
+    hasher.updateValue (audioHash.getHash());
+    addSettingsToKey (hasher, modelId, analysisSettings);
+
+    return "c" + hasher.toHexString();
+}
+
+//==============================================================================
+bool AnalysisResultCache::lookupFile (const String& fileKey, AnalysisResult& result)
+{
+    if (!settings.enabled || fileKey.isEmpty())
+        return false;
+
+    auto reference = getReferenceFile (fileKey);
+
+    if (!reference.existsAsFile())
+        return false;
+
+    if (!lookupContent (reference.loadFileAsString().trim(), result))
+        return false;
+
+    ///Evicted like the entries, a reference in use must look used too
+    reference.setLastModificationTime (Time::getCurrentTime());
+    return true;
+}
+
+bool AnalysisResultCache::lookupContent (const String& contentKey, AnalysisResult& result)
+{
+    if (!settings.enabled || contentKey.isEmpty())
+        return false;
+
+    ///Modification time is the LRU clock, shared with the other instances using the directory
+    auto entry = getEntryFile (contentKey);
+
+    auto inMemory = memoryCache.find (contentKey);
+    if (inMemory != memoryCache.end())
+    {
+        entry.setLastModificationTime (Time::getCurrentTime());
+        result = inMemory->second;
+        return true;
+    }
+
+    MemoryBlock data;
+
+    if (!entry.existsAsFile() || !entry.loadFileAsData (data))
+        return false;
+
+    MemoryInputStream in (data, false);
+
+    if (!readResult (in, result))
+        return false;
+
+    entry.setLastModificationTime (Time::getCurrentTime());
+
+    result.fromCache = true;
+    rememberInMemory (contentKey, result);
+    return true;
+}
+
+void AnalysisResultCache::store (const String& fileKey, const String& contentKey, const AnalysisResult& result)
+{
+    if (!settings.enabled)
+        return;
+
+    MemoryOutputStream entry;
+    writeResult (entry, result);
+
+    {
+        const ScopedLock sl (processLock);
+        const InterProcessLock::ScopedLockType ipl (interProcessLock);
+
+        ///Only made once something is stored, a disabled cache leaves no trace
+        directory.createDirectory();
+
+        if (!totalsLoaded)
+            countFiles();
+
+        auto entryFile = getEntryFile (contentKey);
+
+        if (entryFile.existsAsFile())
+        {
+            entryFile.setLastModificationTime (Time::getCurrentTime());
+        }
+        else if (writeFileAtomically (entryFile, entry.getData(), entry.getDataSize()))
+        {
+            knownBytes += (int64) entry.getDataSize();
+            ++knownEntries;
+        }
+
+        writeReference (fileKey, contentKey);
+
+        if (knownBytes > settings.maxBytes || knownEntries > settings.maxEntries)
+            evict();
+    }
+
+    auto cached = result;
+    cached.fromCache = true;
+    rememberInMemory (contentKey, cached);
+}
+
+void AnalysisResultCache::writeReference (const String& referenceKey, const String& contentKey)
+{
+    if (referenceKey.isEmpty())
+        return;
+
+    auto reference = getReferenceFile (referenceKey);
+    auto previousSize = reference.getSize();
+
+    if (writeFileAtomically (reference, contentKey.toRawUTF8(), contentKey.getNumBytesAsUTF8()))
+        knownBytes += (int64) contentKey.getNumBytesAsUTF8() - previousSize;
+}
+
+void AnalysisResultCache::clear()
+{
+    const ScopedLock sl (processLock);
+    const InterProcessLock::ScopedLockType ipl (interProcessLock);
+
+    for (auto& f : directory.findChildFiles (File::findFiles, false, "*.result;*.ref"))
+        f.deleteFile();
+
+    memoryCache.clear();
+    countFiles();
+}
+
+int64 AnalysisResultCache::getTotalBytes() const
+{
+    int64 total = 0;
+
+    for (auto& f : directory.findChildFiles (File::findFiles, false, "*.result;*.ref"))
+        total += f.getSize();
+
+    return total;
+}
+
+int AnalysisResultCache::getNumEntries() const
+{
+    return directory.getNumberOfChildFiles (File::findFiles, "*.result");
+}
+
+//==============================================================================
+void AnalysisResultCache::rememberInMemory (const String& contentKey, const AnalysisResult& result)
+{
+    if (memoryCache.size() >= maxMemoryEntries)
+        memoryCache.clear();
+
+    memoryCache[contentKey] = result;
+}
+
+void AnalysisResultCache::countFiles()
+{
+    knownBytes = 0;
+    knownEntries = 0;
+
+    for (auto& f : directory.findChildFiles (File::findFiles, false, "*.result;*.ref"))
+    {
+        knownBytes += f.getSize();
+        if (f.hasFileExtension ("result"))
+            ++knownEntries;
+    }
+
+    totalsLoaded = true;
+}
+
+void AnalysisResultCache::evict()
+{
+    struct CachedFile
+    {
+        File file;
+        Time lastUsed;
+        int64 size;
+        bool isEntry;
+    };
+
+    ///The totals only follow this instance, the scan also sees what other processes wrote
+    std::vector<CachedFile> files;
+    knownBytes = 0;
+    knownEntries = 0;
+
+    for (auto& f : directory.findChildFiles (File::findFiles, false, "*.result;*.ref"))
+    {
+        files.push_back ({ f, f.getLastModificationTime(), f.getSize(), f.hasFileExtension ("result") });
+        knownBytes += files.back().size;
+        if (files.back().isEntry)
+            ++knownEntries;
+    }
+
+    ///A little below the limits, so the next stores don't all scan again
+    auto targetBytes = settings.maxBytes - settings.maxBytes / 10;
+    auto targetEntries = settings.maxEntries - settings.maxEntries / 10;
+
+    ///Least recently used first, a dangling reference only costs a decode
+    std::sort (files.begin(), files.end(), [] (const CachedFile& a, const CachedFile& b)
+    {
+        return a.lastUsed < b.lastUsed;
+    });
+
+    for (auto& f : files)
+    {
+        if (knownBytes <= targetBytes && knownEntries <= targetEntries)
+            break;
+
+        if (f.file.deleteFile())
+        {
+            knownBytes -= f.size;
+            if (f.isEntry)
+                --knownEntries;
+        }
+    }
+}
+
+//==============================================================================
+void AnalysisResultCache::writeResult (OutputStream& out, const AnalysisResult& result)
+{
+    out.writeInt (entryMagic);
+    out.writeInt ((int) result.effect);
+    out.writeInt (result.numWindows);
+    out.writeInt (result.numClasses);
+
+    out.writeInt ((int) result.classScores.size());
+    out.write (result.classScores.data(), result.classScores.size() * sizeof (float));
+
+    out.writeInt ((int) result.windowLogits.size());
+    out.write (result.windowLogits.data(), result.windowLogits.size() * sizeof (float));
+}
+
+bool AnalysisResultCache::readResult (InputStream& in, AnalysisResult& result)
+{
+    if (in.readInt() != entryMagic)
+        return false;
+
+    result.effect = static_cast<EffectEnum> (jlimit (0, numberOfEffects - 1, in.readInt()));
+    result.numWindows = in.readInt();
+    result.numClasses = in.readInt();
+
+    auto readFloats = [&in] (std::vector<float>& dest)
+    {
+        auto num = in.readInt();
+
+        if (num < 0 || (int64) num * (int64) sizeof (float) > in.getNumBytesRemaining())
+            return false;
+
+        dest.resize ((size_t) num);
+        auto numBytes = (int) (dest.size() * sizeof (float));
+        return in.read (dest.data(), numBytes) == numBytes;
+    };
+
+    return readFloats (result.classScores) && readFloats (result.windowLogits);
+}
+
+bool AnalysisResultCache::writeFileAtomically (const File& target, const void* data, size_t numBytes)
+{
+    TemporaryFile temp (target);
+
+    return temp.getFile().replaceWithData (data, numBytes)
+        && temp.overwriteTargetFileWithTemporary();
+}
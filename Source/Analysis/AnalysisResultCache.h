@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    AnalysisResultCache.h
+    Created: 17 Oct 2026 4:52:33pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "AnalysisTypes.h"
+
+//==============================================================================
+/**
+    Fast non-cryptographic 64-bit hash, fed incrementally.
+
+    Used to identify decoded audio and models, not to protect anything. The
+    result doesn't depend on how the data is split between update() calls.
+*/
+class ContentHasher
+{
+public:
+    ContentHasher() = default;
+
+    void update (const void* data, size_t numBytes);
+
+    template <typename Type>
+    void updateValue (Type value) { update (&value, sizeof (Type)); }
+
+    void updateString (const String& text) { update (text.toRawUTF8(), text.getNumBytesAsUTF8()); }
+
+    uint64 getHash() const;
+
+    String toHexString() const { return String::toHexString ((int64) getHash()).paddedLeft ('0', 16); }
+
+private:
+    void mixWord (uint64 word);
+
+    uint64 state = 0x9e3779b97f4a7c15ull;
+    uint64 totalLength = 0;
+
+    uint8 pending[8] = {};
+    size_t numPending = 0;
+};
+
+//==============================================================================
+/** Size limits of the on-disk cache. */
+struct AnalysisCacheSettings
+{
+    bool enabled = true;
+
+    int64 maxBytes = 64 * 1024 * 1024;
+    int maxEntries = 20000;
+};
+
+//==============================================================================
+/**
+    Persistent cache of classifier results, shared by every plugin instance and
+    the standalone app through a common directory.
+
+    Results are stored under a key made of a hash of the decoded audio, the model
+    identity and the analysis settings. A cheaper key made of the file path, size
+    and modification date points to it, so a file that was already analysed is
+    answered without being decoded at all. A renamed or copied file is decoded
+    again and its new file key then points to the entry already stored.
+
+    Entries are written to a temporary file then renamed, so readers never see a
+    partial entry. Writers and the LRU eviction are serialised between threads
+    and processes. The directory is only scanned when a limit is exceeded, and
+    the eviction then goes a tenth below the limits. A small in-memory table answers repeated lookups without
+    touching the disk.
+*/
+class AnalysisResultCache
+{
+public:
+    explicit AnalysisResultCache (const File& directory = getDefaultDirectory());
+
+    static File getDefaultDirectory();
+
+    void setSettings (const AnalysisCacheSettings& newSettings) { settings = newSettings; }
+    const AnalysisCacheSettings& getSettings() const { return settings; }
+
+    static String makeFileKey (const File& file, const String& modelId, const AnalysisSettings& analysisSettings);
+    static String makeContentKey (const ContentHasher& audioHash, const String& modelId, const AnalysisSettings& analysisSettings);
+
+    bool lookupFile (const String& fileKey, AnalysisResult& result);
+    bool lookupContent (const String& contentKey, AnalysisResult& result);
+
+    void store (const String& fileKey, const String& contentKey, const AnalysisResult& result);
+
+    void clear();
+
+    int64 getTotalBytes() const;
+    int getNumEntries() const;
+
+private:
+    File getEntryFile (const String& contentKey) const { return directory.getChildFile (contentKey + ".result"); }
+    File getReferenceFile (const String& fileKey) const { return directory.getChildFile (fileKey + ".ref"); }
+
+    void rememberInMemory (const String& contentKey, const AnalysisResult& result);
+
+    ///With the locks held
+    void countFiles();
+    void evict();
+    void writeReference (const String& referenceKey, const String& contentKey);
+
+    static void writeResult (OutputStream& out, const AnalysisResult& result);
+    static bool readResult (InputStream& in, AnalysisResult& result);
+
+    static bool writeFileAtomically (const File& target, const void* data, size_t numBytes);
+
+    File directory;
+    AnalysisCacheSettings settings;
+
+    InterProcessLock interProcessLock { "AutoEffectAnalysisCache" };
+
+    ///Size of the directory, counted on the first store then kept up to date with what this
+    ///instance writes, so a store only scans the directory when a limit looks exceeded
+    int64 knownBytes = 0;
+    int knownEntries = 0;
+    bool totalsLoaded = false;
+
+    std::map<String, AnalysisResult> memoryCache;
+    static constexpr size_t maxMemoryEntries = 256;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalysisResultCache)
+};
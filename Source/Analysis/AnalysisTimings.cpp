@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    AnalysisTimings.cpp
+    Created: 19 Oct 2026 10:08:44am
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#include "AnalysisTimings.h"
+
+namespace
+{
+    String escapeCSV (const String& text)
+    {
+        if (!text.containsAnyOf (",\"\n"))
+            return text;
+
+        return "\"" + text.replace ("\"", "\"\"") + "\"";
+    }
+}
+
+const char* AnalysisTimingRecord::getStageName (int stage)
+{
+    switch (stage)
+    {
+        case FileOpen:          return "fileOpen";
+        case CacheLookup:       return "cacheLookup";
+        case Decode:            return "decode";
+        case Resample:          return "resample";
+        case TensorBuild:       return "tensorBuild";
+        case Forward:           return "forward";
+        case PostProcess:       return "postProcess";
+        case UINotification:    return "uiNotification";
+        default:                return "unknown";
+    }
+}
+
+String AnalysisTimingRecord::toCSV (const std::vector<AnalysisTimingRecord>& records)
+{
+    StringArray columns { "jobId", "file", "modelVariant", "startTimeMs", "succeeded", "fromCache",
+                          "numWindows", "audioSeconds", "numAllocations", "totalMs" };
+
+    for (int stage = 0; stage < numStages; ++stage)
+        columns.add (String (getStageName (stage)) + "Ms");
+
+    String csv = columns.joinIntoString (",") + "\n";
+
+    for (auto& record : records)
+    {
+        StringArray values { String (record.jobId), escapeCSV (record.fileName), record.modelVariant,
+                             String (record.startTimeMs), String (record.succeeded ? 1 : 0), String (record.fromCache ? 1 : 0),
+                             String (record.numWindows), String (record.audioSeconds, 3), String (record.numAllocations),
+                             String (record.totalMs, 3) };
+
+        for (int stage = 0; stage < numStages; ++stage)
+            values.add (String (record.stageMs[stage], 3));
+
+        csv << values.joinIntoString (",") << "\n";
+    }
+
+    return csv;
+}
+
+String AnalysisTimingRecord::toJSON (const std::vector<AnalysisTimingRecord>& records)
+{
+    DynamicObject::Ptr machine (new DynamicObject());
+    machine->setProperty ("cpu", SystemStats::getCpuModel());
+    machine->setProperty ("physicalCores", SystemStats::getNumPhysicalCpus());
+    machine->setProperty ("logicalCores", SystemStats::getNumCpus());
+    machine->setProperty ("memoryMB", SystemStats::getMemorySizeInMegabytes());
+    machine->setProperty ("os", SystemStats::getOperatingSystemName());
+
+    Array<var> analyses;
+
+    for (auto& record : records)
+    {
+        DynamicObject::Ptr stages (new DynamicObject());
+        for (int stage = 0; stage < numStages; ++stage)
+            stages->setProperty (getStageName (stage), record.stageMs[stage]);
+
+        DynamicObject::Ptr entry (new DynamicObject());
+        entry->setProperty ("jobId", record.jobId);
+        entry->setProperty ("file", record.fileName);
+        entry->setProperty ("modelVariant", record.modelVariant);
+        entry->setProperty ("startTimeMs", record.startTimeMs);
+        entry->setProperty ("succeeded", record.succeeded);
+        entry->setProperty ("fromCache", record.fromCache);
+        entry->setProperty ("numWindows", record.numWindows);
+        entry->setProperty ("audioSeconds", record.audioSeconds);
+        entry->setProperty ("numAllocations", record.numAllocations);
+        entry->setProperty ("totalMs", record.totalMs);
+        entry->setProperty ("stagesMs", var (stages.get()));
+
+        analyses.add (var (entry.get()));
+    }
+
+    DynamicObject::Ptr root (new DynamicObject());
+    root->setProperty ("machine", var (machine.get()));
+    root->setProperty ("analyses", analyses);
+
+    return JSON::toString (var (root.get()));
+}
@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    AnalysisTimings.h
+    Created: 19 Oct 2026 10:08:44am
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CustomJuceHeader.h"
+
+//==============================================================================
+/** Where the time of one analysis went. Stages that run per chunk are summed. */
+struct AnalysisTimingRecord
+{
+    enum Stage
+    {
+        FileOpen = 0,       ///< Reader creation
+        CacheLookup,        ///< File-key cache lookup
+        Decode,             ///< AudioFormatReader::read and downmix
+        Resample,
+        TensorBuild,        ///< Wrapping the signal buffer as input tensors
+        Forward,
+        PostProcess,        ///< Reading model outputs, score aggregation, cache store
+        UINotification,     ///< From the result being published to its message thread callbacks having run
+        numStages
+    };
+
+    static const char* getStageName (int stage);
+
+    int jobId = 0;
+    String fileName;
+    String modelVariant;
+
+    ///Wall clock time the analysis started, for ordering records from several machines
+    int64 startTimeMs = 0;
+
+    bool succeeded = false;
+    bool fromCache = false;
+    int numWindows = 0;
+    double audioSeconds = 0.0;
+
+    ///-1 unless the build counts allocations
+    int64 numAllocations = -1;
+
+    double totalMs = 0.0;
+
+    ///UINotification stays at -1 until the message thread delivered the result
+    double stageMs[numStages] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, -1.0 };
+
+    ///Time::getMillisecondCounterHiRes() when the result was handed to the UI, not exported
+    double publishedAtMs = 0.0;
+
+    double& operator[] (Stage stage)        { return stageMs[stage]; }
+    double operator[] (Stage stage) const   { return stageMs[stage]; }
+
+    /** One header line, then one line per record. */
+    static String toCSV (const std::vector<AnalysisTimingRecord>& records);
+
+    /** {"machine": {...}, "analyses": [...]}, machine describes the computer that made the records. */
+    static String toJSON (const std::vector<AnalysisTimingRecord>& records);
+};
+
+//==============================================================================
+/** Adds the time spent in its scope to one stage of a record, does nothing without a record. */
+class ScopedStageTimer
+{
+public:
+    ScopedStageTimer (AnalysisTimingRecord* recordToUpdate, AnalysisTimingRecord::Stage stageToTime) noexcept
+        : record (recordToUpdate), stage (stageToTime),
+          startTicks (recordToUpdate != nullptr ? Time::getHighResolutionTicks() : 0)
+    {}
+
+    ~ScopedStageTimer()
+    {
+        if (record != nullptr)
+            (*record)[stage] += Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - startTicks) * 1000.0;
+    }
+
+private:
+    AnalysisTimingRecord* record;
+    AnalysisTimingRecord::Stage stage;
+    int64 startTicks;
+
+    JUCE_DECLARE_NON_COPYABLE (ScopedStageTimer)
+};
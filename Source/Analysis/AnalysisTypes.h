@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+
+    AnalysisTypes.h
+    Created: 17 Oct 2026 11:02:18am
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CustomJuceHeader.h"
+#include "../EffectProcessors.h"
+
+//==============================================================================
+/** How the channels of a file are folded into the mono signal the model takes. */
+enum class DownmixMode
+{
+    FirstChannel,   ///< Left channel only, what the first versions did
+    Mid,            ///< (L + R) / 2, extra surround channels are ignored
+    Mean            ///< Average of every channel
+};
+
+//==============================================================================
+/** How a file is cut before being sent to the classifier. */
+struct AnalysisSettings
+{
+    DownmixMode downmix = DownmixMode::Mid;
+
+    ///Classify the whole file with overlapping windows instead of its first window only
+    bool windowed = true;
+
+    ///Model input size, in samples at the model sample rate
+    int windowLength = 44100;
+
+    ///Distance between two window starts, in samples at the model sample rate
+    int hopLength = 22050;
+
+    ///Maximum number of windows sent in one forward call, bounds memory on long files
+    int maxBatchSize = 8;
+};
+
+//==============================================================================
+/** Rolling classification of the plugin input. */
+struct LiveAnalysisSettings
+{
+    bool enabled = false;
+
+    ///Model input size, in samples at the model sample rate
+    int windowLength = 44100;
+
+    ///How often the latest window is classified, in samples at the model sample rate
+    int hopLength = 11025;
+
+    ///Room for this much captured audio, input arriving while it is full is dropped, applied on the next prepareToPlay
+    double maxCaptureLatencySeconds = 0.5;
+};
+
+//==============================================================================
+/** CPU budget of the analysis, so it doesn't compete with the host audio threads. */
+struct InferenceThreadSettings
+{
+    ///Threads libtorch may use for one forward call, 0 means all cores but reservedAudioCores
+    int intraOpThreads = 0;
+
+    ///Cores left to the host audio workers when intraOpThreads is 0
+    int reservedAudioCores = 2;
+
+    ///Priority of the analysis worker thread, from 0 (lowest) to 10
+    int workerPriority = 2;
+
+    ///Cores the analysis worker may run on, 0 lets the OS decide
+    uint32 affinityMask = 0;
+
+    int getNumIntraOpThreads() const
+    {
+        if (intraOpThreads > 0)
+            return intraOpThreads;
+
+        return jmax (1, SystemStats::getNumPhysicalCpus() - reservedAudioCores);
+    }
+};
+
+//==============================================================================
+/**
+    Lets another thread stop a running analysis. The analysis checks it between
+    decode chunks and between forward batches, so a cancel takes effect within
+    one chunk read or one batch, whatever the length of the file.
+*/
+class AnalysisCancellation
+{
+public:
+    void cancel() noexcept              { cancelled.store (true, std::memory_order_relaxed); }
+    bool isCancelled() const noexcept   { return cancelled.load (std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> cancelled { false };
+};
+
+//==============================================================================
+/** Output of the classifier for one file. */
+struct AnalysisResult
+{
+    EffectEnum effect = EffectEnum::Dry;
+
+    int numWindows = 0;
+    int numClasses = 0;
+
+    ///numWindows * numClasses scores, row by row. One-hot votes if the model only returns class indices
+    std::vector<float> windowLogits;
+
+    ///Mean of windowLogits over all windows, 'effect' is its argmax
+    std::vector<float> classScores;
+
+    ///True when the result was read back from the analysis cache
+    bool fromCache = false;
+
+    /** Mean over windows of each window's class distribution: the softmax of its logits,
+        or its scores as they are when the model already returns probabilities or votes.
+    */
+    std::vector<float> getClassProbabilities() const
+    {
+        std::vector<float> probabilities ((size_t) jmax (0, numClasses), 0.f);
+
+        if (numWindows <= 0 || numClasses <= 0 || windowLogits.size() < (size_t) numWindows * (size_t) numClasses)
+            return probabilities;
+
+        std::vector<float> row ((size_t) numClasses);
+
+        for (int w = 0; w < numWindows; ++w)
+        {
+            auto* scores = windowLogits.data() + (size_t) w * (size_t) numClasses;
+            auto range = FloatVectorOperations::findMinAndMax (scores, numClasses);
+
+            double sum = 0.0;
+            for (int c = 0; c < numClasses; ++c)
+                sum += scores[c];
+
+            if (range.getStart() >= 0.f && std::abs (sum - 1.0) < 1.0e-3)
+            {
+                FloatVectorOperations::copy (row.data(), scores, numClasses);
+            }
+            else
+            {
+                sum = 0.0;
+                for (int c = 0; c < numClasses; ++c)
+                    sum += (row[(size_t) c] = std::exp (scores[c] - range.getEnd()));
+
+                FloatVectorOperations::multiply (row.data(), (float) (1.0 / sum), numClasses);
+            }
+
+            FloatVectorOperations::add (probabilities.data(), row.data(), numClasses);
+        }
+
+        FloatVectorOperations::multiply (probabilities.data(), 1.f / (float) numWindows, numClasses);
+        return probabilities;
+    }
+};
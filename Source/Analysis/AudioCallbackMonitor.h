@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    AudioCallbackMonitor.h
+    Created: 17 Oct 2026 3:40:51pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CustomJuceHeader.h"
+
+//==============================================================================
+/**
+    Measurement mode counting audio callbacks that went wrong, split between
+    callbacks that happened while an analysis was running and the others.
+
+    - an overrun is a processBlock that took longer than the audio it processed
+    - a late callback is a processBlock started more than 1.5 block after the
+      previous one, which is what the host produces when it drops a buffer
+
+    Only atomics are touched, it is safe to call from the audio thread.
+*/
+class AudioCallbackMonitor
+{
+public:
+    AudioCallbackMonitor() = default;
+
+    struct Counters {
+        int64 numCallbacks = 0;
+        int64 numOverruns = 0;
+        int64 numLateCallbacks = 0;
+        ///Worst processBlock duration divided by the block duration
+        float worstLoad = 0.f;
+    };
+
+    struct Stats {
+        Counters duringAnalysis;
+        Counters withoutAnalysis;
+    };
+
+    void setEnabled (bool shouldBeEnabled) { enabled = shouldBeEnabled; }
+    bool isEnabled() const { return enabled; }
+
+    void prepare (double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        lastStartTicks = 0;
+    }
+
+    void blockStarted()
+    {
+        if (!enabled)
+        {
+            currentStartTicks = 0;
+            lastStartTicks = 0;
+            return;
+        }
+
+        currentStartTicks = Time::getHighResolutionTicks();
+    }
+
+    void blockFinished (int numSamples, bool analysisRunning)
+    {
+        if (!enabled || currentStartTicks == 0 || sampleRate <= 0.0 || numSamples <= 0)
+            return;
+
+        auto endTicks = Time::getHighResolutionTicks();
+        auto blockSeconds = (double) numSamples / sampleRate;
+        auto& c = counters[analysisRunning ? 1 : 0];
+
+        auto load = (float) (Time::highResolutionTicksToSeconds (endTicks - currentStartTicks) / blockSeconds);
+
+        c.numCallbacks.fetch_add (1, std::memory_order_relaxed);
+
+        if (load > 1.f)
+            c.numOverruns.fetch_add (1, std::memory_order_relaxed);
+
+        if (load > c.worstLoad.load (std::memory_order_relaxed))
+            c.worstLoad.store (load, std::memory_order_relaxed);
+
+        if (lastStartTicks != 0
+            && Time::highResolutionTicksToSeconds (currentStartTicks - lastStartTicks) > 1.5 * blockSeconds)
+            c.numLateCallbacks.fetch_add (1, std::memory_order_relaxed);
+
+        lastStartTicks = currentStartTicks;
+    }
+
+    Stats getStats() const
+    {
+        return { read (counters[1]), read (counters[0]) };
+    }
+
+    void reset()
+    {
+        for (auto& c : counters)
+        {
+            c.numCallbacks = 0;
+            c.numOverruns = 0;
+            c.numLateCallbacks = 0;
+            c.worstLoad = 0.f;
+        }
+    }
+
+private:
+    struct AtomicCounters {
+        std::atomic<int64> numCallbacks { 0 };
+        std::atomic<int64> numOverruns { 0 };
+        std::atomic<int64> numLateCallbacks { 0 };
+        std::atomic<float> worstLoad { 0.f };
+    };
+
+    static Counters read (const AtomicCounters& c)
+    {
+        return { c.numCallbacks.load(), c.numOverruns.load(), c.numLateCallbacks.load(), c.worstLoad.load() };
+    }
+
+    std::atomic<bool> enabled { false };
+    double sampleRate = 0.0;
+
+    ///Only touched by the audio thread
+    int64 currentStartTicks = 0;
+    int64 lastStartTicks = 0;
+
+    ///[0] without analysis, [1] during analysis
+    AtomicCounters counters[2];
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioCallbackMonitor)
+};
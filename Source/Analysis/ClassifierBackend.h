@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    ClassifierBackend.h
+    Created: 20 Oct 2026 2:37:50pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CustomJuceHeader.h"
+
+///Off in builds that don't link libtorch, only compact models can then be loaded
+#ifndef AUTOEFFECT_WITH_LIBTORCH
+ #define AUTOEFFECT_WITH_LIBTORCH 1
+#endif
+
+//==============================================================================
+/**
+    Rows sent to one forward call, read in place from the caller's buffer.
+
+    Row i starts rowStride floats after row i - 1. The stride may be shorter than a
+    row, overlapping windows are then views over the same memory. Inside a row the
+    values are contiguous, frame after frame, numChannels values per frame.
+*/
+struct ClassifierInput
+{
+    const float* data = nullptr;
+    int numRows = 1;
+
+    ///Samples per row for waveform models, frames per row for spectrogram models
+    int numFrames = 0;
+
+    ///1 for waveform models, mel bands for spectrogram models
+    int numChannels = 1;
+
+    int64 rowStride = 0;
+
+    ///Waveform rows are [samples], spectrogram rows are [frames, channels]
+    bool isSpectrogram = false;
+};
+
+//==============================================================================
+/**
+    The inference engine behind SharedClassifier.
+
+    Only the implementation files know about the engine they wrap, so nothing
+    including SharedClassifier.h pulls libtorch headers in. Backends are created by
+    SharedClassifier from the model data, after the metadata check, and forward()
+    may be called from several threads at once.
+*/
+class ClassifierBackend
+{
+public:
+    virtual ~ClassifierBackend() = default;
+
+    ///Short name for logs and benchmarks, like "libtorch"
+    virtual String getName() const = 0;
+
+    /** Replaces output with the values the model returns, row after row.
+        Throws std::exception if the model can't run this input, for instance a model
+        that only accepts one row at a time.
+    */
+    virtual void forward (const ClassifierInput& input, std::vector<float>& output, int numThreads) = 0;
+
+    /** True if the weights stay where the model data was, the data must then outlive the
+        backend. False if the model was copied out and the data can be released after loading.
+    */
+    virtual bool readsWeightsInPlace() const = 0;
+};
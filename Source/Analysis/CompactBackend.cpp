@@ -0,0 +1,230 @@
+/*
+  ==============================================================================
+
+    CompactBackend.cpp
+    Created: 20 Oct 2026 2:37:50pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#include "CompactBackend.h"
+
+namespace
+{
+    constexpr char magic[4] = { 'A', 'E', 'N', 'T' };
+    constexpr size_t headerSize = 12;
+
+    uint32 readUInt32 (const char* data)
+    {
+        uint32 value;
+        std::memcpy (&value, data, sizeof (value));
+        return ByteOrder::swapIfBigEndian (value);
+    }
+
+    size_t getPaddedSize (size_t size) { return (size + 3) & ~(size_t) 3; }
+}
+
+bool CompactBackend::isCompactModel (const char* data, size_t size)
+{
+    return data != nullptr && size >= headerSize && std::memcmp (data, magic, sizeof (magic)) == 0;
+}
+
+String CompactBackend::readMetadata (const char* data, size_t size)
+{
+    if (!isCompactModel (data, size))
+        return {};
+
+    auto metadataSize = (size_t) readUInt32 (data + 8);
+    if (headerSize + metadataSize > size)
+        return {};
+
+    return String::fromUTF8 (data + headerSize, (int) metadataSize);
+}
+
+CompactBackend::CompactBackend (const char* data, size_t size)
+{
+    if (!isCompactModel (data, size))
+        throw std::runtime_error ("not a compact model");
+
+    auto version = readUInt32 (data + 4);
+    if (version != fileFormatVersion)
+        throw std::runtime_error ("compact model file version " + std::to_string (version) + ", this build reads version "
+                                  + std::to_string (fileFormatVersion));
+
+    auto position = headerSize + getPaddedSize ((size_t) readUInt32 (data + 8));
+
+    auto take = [&] (size_t numBytes)
+    {
+        if (position + numBytes > size)
+            throw std::runtime_error ("truncated compact model");
+
+        auto* start = data + position;
+        position += numBytes;
+        return start;
+    };
+
+    ///Weights are used in place when they are aligned, which a mapped file always is
+    auto* base = data;
+    if ((reinterpret_cast<uintptr_t> (data) & (alignof (float) - 1)) != 0)
+    {
+        copiedWeights.replaceAll (data, size);
+        base = static_cast<const char*> (copiedWeights.getData());
+    }
+
+    auto takeFloats = [&] (int64 numFloats)
+    {
+        auto* start = take ((size_t) numFloats * sizeof (float));
+        numParameters += numFloats;
+        return reinterpret_cast<const float*> (base + (start - data));
+    };
+
+    auto numLayers = (int) readUInt32 (take (4));
+    int channels = 0;
+
+    for (int i = 0; i < numLayers; ++i)
+    {
+        auto* header = take (20);
+        Layer layer;
+        layer.type = static_cast<LayerType> (readUInt32 (header));
+
+        int params[4];
+        for (int p = 0; p < 4; ++p)
+            params[p] = (int) readUInt32 (header + 4 + 4 * p);
+
+        switch (layer.type)
+        {
+            case Conv1d:
+                layer.inChannels = params[0];
+                layer.outChannels = params[1];
+                layer.kernelSize = params[2];
+                layer.stride = params[3];
+
+                if (layer.inChannels <= 0 || layer.outChannels <= 0 || layer.kernelSize <= 0 || layer.stride <= 0)
+                    throw std::runtime_error ("invalid convolution layer");
+
+                if (channels != 0 && channels != layer.inChannels)
+                    throw std::runtime_error ("convolution layer " + std::to_string (i) + " does not chain");
+
+                layer.weights = takeFloats ((int64) layer.outChannels * layer.kernelSize * layer.inChannels);
+                layer.bias = takeFloats (layer.outChannels);
+                channels = layer.outChannels;
+                break;
+
+            case Linear:
+                layer.inChannels = params[0];
+                layer.outChannels = params[1];
+
+                if (layer.inChannels <= 0 || layer.outChannels <= 0)
+                    throw std::runtime_error ("invalid linear layer");
+
+                layer.weights = takeFloats ((int64) layer.outChannels * layer.inChannels);
+                layer.bias = takeFloats (layer.outChannels);
+                channels = layer.outChannels;
+                break;
+
+            case ReLU:
+            case MeanPool:
+                break;
+
+            default:
+                throw std::runtime_error ("unknown layer type " + std::to_string ((uint32) layer.type));
+        }
+
+        layers.push_back (layer);
+    }
+
+    if (layers.empty())
+        throw std::runtime_error ("compact model without layers");
+}
+
+void CompactBackend::forward (const ClassifierInput& input, std::vector<float>& output, int)
+{
+    ///Ping-pong activations of this thread, [time, channels]
+    thread_local std::vector<float> buffers[2];
+
+    output.clear();
+
+    for (int row = 0; row < input.numRows; ++row)
+    {
+        const float* current = input.data + (size_t) row * (size_t) input.rowStride;
+        int numFrames = input.numFrames;
+        int channels = input.numChannels;
+        int target = 0;
+
+        for (auto& layer : layers)
+        {
+            auto& next = buffers[target];
+
+            switch (layer.type)
+            {
+                case Conv1d:
+                {
+                    if (channels != layer.inChannels || numFrames < layer.kernelSize)
+                        throw std::runtime_error ("input does not fit the first convolution");
+
+                    auto outFrames = (numFrames - layer.kernelSize) / layer.stride + 1;
+                    auto span = layer.kernelSize * channels;
+                    next.resize ((size_t) outFrames * (size_t) layer.outChannels);
+
+                    for (int t = 0; t < outFrames; ++t)
+                    {
+                        ///The kernel span is contiguous in channels-last layout
+                        auto* window = current + (size_t) t * (size_t) layer.stride * (size_t) channels;
+                        auto* out = next.data() + (size_t) t * (size_t) layer.outChannels;
+
+                        for (int oc = 0; oc < layer.outChannels; ++oc)
+                            out[oc] = layer.bias[oc] + VectorKernels::dotProduct (window, layer.weights + (size_t) oc * (size_t) span, span);
+                    }
+
+                    numFrames = outFrames;
+                    channels = layer.outChannels;
+                    break;
+                }
+
+                case Linear:
+                {
+                    auto numInputs = numFrames * channels;
+                    if (numInputs != layer.inChannels)
+                        throw std::runtime_error ("linear layer expects " + std::to_string (layer.inChannels) + " inputs, got "
+                                                  + std::to_string (numInputs));
+
+                    next.resize ((size_t) layer.outChannels);
+
+                    for (int o = 0; o < layer.outChannels; ++o)
+                        next[(size_t) o] = layer.bias[o] + VectorKernels::dotProduct (current, layer.weights + (size_t) o * (size_t) numInputs, numInputs);
+
+                    numFrames = 1;
+                    channels = layer.outChannels;
+                    break;
+                }
+
+                case ReLU:
+                {
+                    auto num = numFrames * channels;
+                    next.resize ((size_t) num);
+                    FloatVectorOperations::max (next.data(), current, 0.f, num);
+                    break;
+                }
+
+                case MeanPool:
+                {
+                    next.resize ((size_t) channels);
+                    FloatVectorOperations::copy (next.data(), current, channels);
+
+                    for (int t = 1; t < numFrames; ++t)
+                        FloatVectorOperations::add (next.data(), current + (size_t) t * (size_t) channels, channels);
+
+                    FloatVectorOperations::multiply (next.data(), 1.f / (float) jmax (1, numFrames), channels);
+                    numFrames = 1;
+                    break;
+                }
+            }
+
+            current = next.data();
+            target = 1 - target;
+        }
+
+        output.insert (output.end(), current, current + (size_t) numFrames * (size_t) channels);
+    }
+}
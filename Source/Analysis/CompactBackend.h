@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    CompactBackend.h
+    Created: 20 Oct 2026 2:37:50pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ClassifierBackend.h"
+#include "VectorKernels.h"
+
+//==============================================================================
+/**
+    Dependency-free backend for small networks exported by Scripts/export_compact_classifier.py.
+
+    The network is a chain of 1-D convolutions over time, ReLUs, a mean over time
+    and fully connected layers, which covers small classifiers on samples or
+    log-mel frames. Activations are kept channels-last, [time, channels], so every
+    output value of a convolution or a linear layer is one contiguous dot product
+    run by VectorKernels::dotProduct.
+
+    File layout, little-endian:
+    @code
+    "AENT"  uint32 formatVersion  uint32 metadataSize  metadata JSON (zero padded to 4 bytes)
+    uint32 numLayers
+    per layer: uint32 type, uint32 params[4], then float weights and bias
+        Conv1d   params = inChannels, outChannels, kernelSize, stride
+                 weights [outChannels][kernelSize][inChannels], bias [outChannels]
+        Linear   params = inFeatures, outFeatures, 0, 0
+                 weights [outFeatures][inFeatures], bias [outFeatures]
+        ReLU, MeanPool   no params used, no weights
+    @endcode
+
+    Weights are read where the data is, a mapped model file is never copied. Scratch
+    buffers are per thread, so forward() can run on several threads at once and
+    doesn't allocate once a thread has seen the biggest input.
+*/
+class CompactBackend : public ClassifierBackend
+{
+public:
+    static constexpr uint32 fileFormatVersion = 1;
+
+    enum LayerType : uint32
+    {
+        Conv1d = 1,
+        ReLU,
+        MeanPool,
+        Linear
+    };
+
+    ///True if the data starts like a compact model, whatever its version
+    static bool isCompactModel (const char* data, size_t size);
+
+    ///The metadata JSON stored in the header, empty if the data isn't a compact model
+    static String readMetadata (const char* data, size_t size);
+
+    /** Throws std::runtime_error if the data is truncated, of another version or if
+        the layers don't chain. The data must outlive the backend.
+    */
+    CompactBackend (const char* data, size_t size);
+
+    String getName() const override { return "compact"; }
+
+    bool readsWeightsInPlace() const override { return copiedWeights.getData() == nullptr; }
+
+    void forward (const ClassifierInput& input, std::vector<float>& output, int numThreads) override;
+
+    int getNumLayers() const noexcept { return (int) layers.size(); }
+    int64 getNumParameters() const noexcept { return numParameters; }
+
+private:
+    struct Layer
+    {
+        LayerType type = ReLU;
+        int inChannels = 0;
+        int outChannels = 0;
+        int kernelSize = 0;
+        int stride = 1;
+        const float* weights = nullptr;
+        const float* bias = nullptr;
+    };
+
+    std::vector<Layer> layers;
+    int64 numParameters = 0;
+
+    ///Only used if the data isn't aligned for floats, which embedded binary data may not be
+    MemoryBlock copiedWeights;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CompactBackend)
+};
@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+    FileAnalyser.cpp
+    Created: 19 Oct 2026 2:12:09pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#include "FileAnalyser.h"
+
+FileAnalyser::FileAnalyser (double sampleRateOfModel)
+    : modelSampleRate (sampleRateOfModel)
+{
+    formatManager.registerBasicFormats();
+}
+
+std::unique_ptr<AudioFormatReader> FileAnalyser::createReader (const File& file)
+{
+    if (useMemoryMapping)
+    {
+        if (auto* format = formatManager.findFormatForFileExtension (file.getFileExtension()))
+        {
+            std::unique_ptr<MemoryMappedAudioFormatReader> mapped (format->createMemoryMappedReader (file));
+
+            ///Header parsed fine, sample data is mapped lazily
+            if (mapped != nullptr && mapped->lengthInSamples > 0 && mapped->sampleRate > 0.0)
+                return mapped;
+        }
+    }
+
+    return std::unique_ptr<AudioFormatReader> (formatManager.createReaderFor (file));
+}
+
+bool FileAnalyser::fail (const String& message)
+{
+    lastError = message;
+    Logger::writeToLog (message);
+    return false;
+}
+
+bool FileAnalyser::analyse (const File& targetFile, SharedClassifier& model, const AnalysisSettings& settings,
+                            AnalysisResult& result, AnalysisTimingRecord* timings,
+                            const AnalysisCancellation* cancellation)
+{
+    auto isCancelled = [cancellation] { return cancellation != nullptr && cancellation->isCancelled(); };
+    lastError = {};
+
+    // Check that the file exists and that we can have a reader
+    if (!targetFile.existsAsFile())
+    {
+        return fail ("Could not find track file " + targetFile.getFileName());
+    }
+
+    auto modelId = model.getModelId();
+    String fileKey;
+    std::unique_ptr<AudioFormatReader> reader;
+
+    {
+        ScopedStageTimer timer (timings, AnalysisTimingRecord::CacheLookup);
+
+        ///Same path, size and date as a previous analysis, nothing to decode. Anything else, even a
+        ///renamed copy, is decoded and then finds its entry again through the content key
+        fileKey = AnalysisResultCache::makeFileKey (targetFile, modelId, settings);
+        if (resultCache.lookupFile (fileKey, result))
+        {
+            if (timings != nullptr)
+                timings->fromCache = true;
+            return true;
+        }
+    }
+
+    {
+        ScopedStageTimer timer (timings, AnalysisTimingRecord::FileOpen);
+        reader = createReader (targetFile);
+    }
+
+    if (reader == nullptr)
+    {
+        return fail ("Could not load track from file " + targetFile.getFileName());
+    }
+
+    if (timings != nullptr)
+        timings->audioSeconds = reader->sampleRate > 0.0 ? (double) reader->lengthInSamples / reader->sampleRate : 0.0;
+
+    // 1) Decode and resample chunk by chunk, 2) classify batches of windows as soon as they are complete
+
+    modelInput.setTimings (timings);
+    windowedClassifier.setTimings (timings);
+    windowedClassifier.setCancellation (cancellation);
+
+    bool classified = false;
+
+    try
+    {
+        modelInput.reset (*reader, modelSampleRate, settings.downmix);
+        windowedClassifier.reset (settings);
+
+        ///The reader resamples straight into the classifier signal buffer, which backs the input tensors
+        int numSamples = 0;
+
+        while (windowedClassifier.needsMoreSamples()
+               && modelInput.readNextBlock (windowedClassifier.getWritePointer (modelInput.getMaxBlockSize()), numSamples))
+        {
+            windowedClassifier.commitSamples (model, numSamples);
+
+            if (onProgress != nullptr)
+                onProgress ((double) modelInput.getNumSourceSamplesRead() / (double) jmax ((int64) 1, reader->lengthInSamples));
+        }
+
+        // 3) Aggregate the scores of every window, unless the loop stopped on a cancel
+        if (!isCancelled())
+        {
+            result = windowedClassifier.finish (model);
+            classified = true;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        fail ("Classifier failed on " + targetFile.getFileName() + ": " + e.what());
+    }
+
+    modelInput.setTimings (nullptr);
+    windowedClassifier.setTimings (nullptr);
+    windowedClassifier.setCancellation (nullptr);
+
+    if (!classified)
+        return false;
+
+    DBG (result.effect << " over " << result.numWindows << " windows");
+
+    ///Hashed during the single decode pass, it covers exactly the audio the windows were made of
+    ScopedStageTimer timer (timings, AnalysisTimingRecord::PostProcess);
+    auto contentKey = AnalysisResultCache::makeContentKey (modelInput.getDecodedAudioHash(), modelId, settings);
+    resultCache.store (fileKey, contentKey, result);
+
+    return true;
+}
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    FileAnalyser.h
+    Created: 19 Oct 2026 2:12:09pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "AnalysisResultCache.h"
+#include "AnalysisTimings.h"
+#include "ModelInputReader.h"
+#include "WindowedClassifier.h"
+
+//==============================================================================
+/**
+    Classifies one audio file after the other: cache lookup, streamed decode and
+    resampling, windowed classification, cache store.
+
+    This is the whole file pipeline of the plugin worker, kept apart so that the
+    command line batch classifier runs exactly the same code. An analyser keeps its
+    buffers from one file to the next and is not thread safe, use one per thread.
+    Several analysers can share the same model.
+*/
+class FileAnalyser
+{
+public:
+    explicit FileAnalyser (double modelSampleRate = 22050.0);
+
+    void setCacheSettings (const AnalysisCacheSettings& newSettings) { resultCache.setSettings (newSettings); }
+
+    /** Returns false and logs why if the file couldn't be classified, or returns false
+        as soon as possible once cancellation is cancelled, without logging.
+        When given, timings gets the time of every stage of this file added to it.
+    */
+    bool analyse (const File& file, SharedClassifier& model, const AnalysisSettings& settings,
+                  AnalysisResult& result, AnalysisTimingRecord* timings = nullptr,
+                  const AnalysisCancellation* cancellation = nullptr);
+
+    ///Wildcard of every format the analyser can read, like "*.wav;*.aiff"
+    String getSupportedWildcard() const { return formatManager.getWildcardForAllFormats(); }
+
+    ///Why the last analyse() call returned false, empty after a success or a cancel
+    const String& getLastError() const { return lastError; }
+
+    ///Called after every decoded chunk with the fraction of the file read so far, on the analysing thread
+    void setProgressCallback (std::function<void (double)> callback) { onProgress = std::move (callback); }
+
+    ///On by default, uncompressed files are then read from a memory map instead of a buffered stream
+    void setUseMemoryMapping (bool shouldUseMemoryMapping) { useMemoryMapping = shouldUseMemoryMapping; }
+
+    /** Memory mapped reader when the format has one (WAV, AIFF), streaming reader otherwise (MP3, FLAC...).
+        Nothing is mapped yet, ModelInputReader maps the sections it reads.
+    */
+    std::unique_ptr<AudioFormatReader> createReader (const File& file);
+
+private:
+    bool fail (const String& message);
+
+    const double modelSampleRate;
+
+    AudioFormatManager formatManager;
+    ModelInputReader modelInput;
+    WindowedClassifier windowedClassifier;
+
+    AnalysisResultCache resultCache;
+
+    bool useMemoryMapping = true;
+
+    String lastError;
+    std::function<void (double)> onProgress;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FileAnalyser)
+};
@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    LiveClassifier.cpp
+    Created: 18 Oct 2026 2:40:05pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#include "LiveClassifier.h"
+
+void LiveClassifier::reset (double captureRate, double modelSampleRate, const LiveAnalysisSettings& newSettings)
+{
+    settings = newSettings;
+    settings.windowLength = jmax (1, settings.windowLength);
+    settings.hopLength = jmax (1, settings.hopLength);
+
+    preparedRate = captureRate;
+    resampler = std::make_unique<PolyphaseResampler> (captureRate, modelSampleRate);
+
+    captured.resize ((size_t) pullSize);
+    resampled.resize ((size_t) resampler->getMaxNumOutputSamples (pullSize));
+    window.assign ((size_t) settings.windowLength, 0.f);
+    numInWindow = 0;
+    numSinceLastWindow = 0;
+}
+
+void LiveClassifier::restart (LiveInputCapture& capture)
+{
+    capture.discardPending();
+    numDroppedAtRestart = capture.getNumDroppedSamples();
+
+    if (resampler != nullptr)
+        resampler->reset();
+
+    numInWindow = 0;
+    numSinceLastWindow = 0;
+}
+
+bool LiveClassifier::update (LiveInputCapture& capture, SharedClassifier& model, AnalysisResult& result)
+{
+    if (!pullCaptured (capture))
+        return false;
+
+    numSinceLastWindow = 0;
+
+    AnalysisSettings windowSettings;
+    windowSettings.windowed = false;
+    windowSettings.windowLength = settings.windowLength;
+
+    result = windowClassifier.classify (model, window.data(), settings.windowLength, windowSettings);
+    return true;
+}
+
+bool LiveClassifier::pullCaptured (LiveInputCapture& capture)
+{
+    if (resampler == nullptr)
+        return false;
+
+    ///Input was dropped while this audio waited, it is older than anything played since
+    if (capture.getNumDroppedSamples() != numDroppedAtRestart)
+        restart (capture);
+
+    for (;;)
+    {
+        auto numCaptured = capture.pull (captured.data(), pullSize);
+
+        if (numCaptured == 0)
+            break;
+
+        auto numResampled = resampler->process (captured.data(), numCaptured, resampled.data());
+        appendToWindow (resampled.data(), numResampled);
+    }
+
+    return numInWindow >= settings.windowLength && numSinceLastWindow >= settings.hopLength;
+}
+
+void LiveClassifier::appendToWindow (const float* samples, int numSamples)
+{
+    const int windowLength = settings.windowLength;
+
+    numSinceLastWindow += numSamples;
+
+    ///Only the end of a long block can end up in the window
+    if (numSamples > windowLength)
+    {
+        samples += numSamples - windowLength;
+        numSamples = windowLength;
+    }
+
+    auto overflow = numInWindow + numSamples - windowLength;
+
+    if (overflow > 0)
+    {
+        numInWindow -= overflow;
+        std::memmove (window.data(), window.data() + overflow, (size_t) numInWindow * sizeof (float));
+    }
+
+    FloatVectorOperations::copy (window.data() + numInWindow, samples, numSamples);
+    numInWindow += numSamples;
+}
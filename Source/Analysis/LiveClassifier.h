@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    LiveClassifier.h
+    Created: 18 Oct 2026 2:40:05pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "WindowedClassifier.h"
+#include "PolyphaseResampler.h"
+#include "LiveInputCapture.h"
+
+//==============================================================================
+/**
+    Worker side of the live mode: drains a LiveInputCapture, brings it to the
+    model sample rate and classifies the latest window every hop.
+
+    When the worker falls behind (e.g. a file analysis is running) only the
+    latest window is classified, windows are never queued up. The capture drops
+    the newest input once it is full, so as soon as it has dropped anything the
+    audio still waiting in it is discarded and the window starts again from
+    what is captured next.
+*/
+class LiveClassifier
+{
+public:
+    LiveClassifier() = default;
+
+    /** Forgets the current window and prepares for audio captured at captureRate. */
+    void reset (double captureRate, double modelSampleRate, const LiveAnalysisSettings& newSettings);
+
+    bool isPreparedFor (double captureRate) const { return resampler != nullptr && captureRate == preparedRate; }
+
+    /** Forgets the current window and the audio waiting in the capture, the next window is made
+        of audio captured from now on. The worker calls it when it comes back from a long job.
+    */
+    void restart (LiveInputCapture& capture);
+
+    /** Pulls what the audio thread captured since the last call.
+        Returns true when 'result' holds the classification of a new window.
+    */
+    bool update (LiveInputCapture& capture, SharedClassifier& model, AnalysisResult& result);
+
+    /** The part of update() before classifying: drains the capture into the window and
+        returns true when a new window is due.
+    */
+    bool pullCaptured (LiveInputCapture& capture);
+
+    ///Latest windowLength samples at the model sample rate, oldest first, valid once pullCaptured() returned true
+    const float* getWindow() const { return window.data(); }
+
+private:
+    void appendToWindow (const float* samples, int numSamples);
+
+    LiveAnalysisSettings settings;
+    double preparedRate = 0.0;
+
+    std::unique_ptr<PolyphaseResampler> resampler;
+    std::vector<float> captured;
+    std::vector<float> resampled;
+
+    ///Latest windowLength samples at the model sample rate, oldest first
+    std::vector<float> window;
+    int numInWindow = 0;
+    int numSinceLastWindow = 0;
+
+    ///Dropped count of the capture when its pending audio was last discarded
+    int64 numDroppedAtRestart = 0;
+
+    WindowedClassifier windowClassifier;
+
+    static constexpr int pullSize = 8192;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LiveClassifier)
+};
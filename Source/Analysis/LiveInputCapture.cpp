@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    LiveInputCapture.cpp
+    Created: 18 Oct 2026 2:40:05pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#include "LiveInputCapture.h"
+
+void LiveInputCapture::prepare (double newSampleRate, double maxLatencySeconds)
+{
+    const ScopedLock sl (prepareLock);
+
+    auto newCapacity = jmax (1024, (int) std::ceil (newSampleRate * maxLatencySeconds));
+
+    ///AbstractFifo keeps one slot free
+    if ((int) ring.size() != newCapacity + 1)
+    {
+        ring.assign ((size_t) newCapacity + 1, 0.f);
+        fifo.setTotalSize (newCapacity + 1);
+    }
+
+    fifo.reset();
+    numDroppedSamples = 0;
+    capacity = newCapacity;
+    sampleRate = newSampleRate;
+}
+
+void LiveInputCapture::pushBlock (const AudioBuffer<float>& buffer, int numChannels) noexcept
+{
+    if (!enabled || capacity.load() == 0)
+        return;
+
+    auto numToMix = jmin (2, numChannels, buffer.getNumChannels());
+    auto numSamples = buffer.getNumSamples();
+
+    if (numToMix <= 0 || numSamples <= 0)
+        return;
+
+    auto numToWrite = jmin (numSamples, fifo.getFreeSpace());
+    numDroppedSamples += numSamples - numToWrite;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite (numToWrite, start1, size1, start2, size2);
+
+    auto gain = 1.f / (float) numToMix;
+
+    auto mixInto = [&] (int ringStart, int sourceStart, int num)
+    {
+        if (num <= 0)
+            return;
+
+        FloatVectorOperations::multiply (ring.data() + ringStart, buffer.getReadPointer (0, sourceStart), gain, num);
+
+        if (numToMix > 1)
+            FloatVectorOperations::addWithMultiply (ring.data() + ringStart, buffer.getReadPointer (1, sourceStart), gain, num);
+    };
+
+    mixInto (start1, 0, size1);
+    mixInto (start2, size1, size2);
+
+    fifo.finishedWrite (size1 + size2);
+}
+
+int LiveInputCapture::pull (float* destination, int maxSamples)
+{
+    const ScopedLock sl (prepareLock);
+
+    int start1, size1, start2, size2;
+    fifo.prepareToRead (maxSamples, start1, size1, start2, size2);
+
+    if (size1 > 0)
+        FloatVectorOperations::copy (destination, ring.data() + start1, size1);
+    if (size2 > 0)
+        FloatVectorOperations::copy (destination + size1, ring.data() + start2, size2);
+
+    fifo.finishedRead (size1 + size2);
+    return size1 + size2;
+}
+
+void LiveInputCapture::discardPending()
+{
+    const ScopedLock sl (prepareLock);
+    fifo.finishedRead (fifo.getNumReady());
+}
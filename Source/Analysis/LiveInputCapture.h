@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+    LiveInputCapture.h
+    Created: 18 Oct 2026 2:40:05pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CustomJuceHeader.h"
+
+//==============================================================================
+/**
+    Single producer / single consumer ring carrying the plugin input from the
+    audio thread to the analysis worker.
+
+    The audio thread only does a downmix into preallocated memory and never
+    waits: what doesn't fit is dropped and counted. Once full the ring keeps its
+    oldest audio and drops the newest, so a consumer that fell behind has to
+    check getNumDroppedSamples() and discardPending() rather than analyse what
+    is waiting.
+*/
+class LiveInputCapture
+{
+public:
+    LiveInputCapture() = default;
+
+    /** Allocates room for maxLatencySeconds of audio.
+        Not realtime safe, call it from prepareToPlay while processBlock can't run.
+    */
+    void prepare (double newSampleRate, double maxLatencySeconds);
+
+    void setEnabled (bool shouldCapture) { enabled = shouldCapture; }
+    bool isEnabled() const { return enabled; }
+
+    /** Audio thread. Writes the mid of the first two channels, lock and allocation free. */
+    void pushBlock (const AudioBuffer<float>& buffer, int numChannels) noexcept;
+
+    /** Worker thread. Reads at most maxSamples mono samples, returns how many were read. */
+    int pull (float* destination, int maxSamples);
+
+    ///Worker thread, forgets what was captured before a (re)start
+    void discardPending();
+
+    double getSampleRate() const { return sampleRate; }
+    int getCapacity() const { return capacity; }
+    int64 getNumDroppedSamples() const { return numDroppedSamples; }
+
+private:
+    ///Between prepare and the worker only, the audio thread never takes it
+    CriticalSection prepareLock;
+
+    AbstractFifo fifo { 1 };
+    std::vector<float> ring;
+
+    std::atomic<double> sampleRate { 0.0 };
+    std::atomic<int> capacity { 0 };
+    std::atomic<bool> enabled { false };
+    std::atomic<int64> numDroppedSamples { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LiveInputCapture)
+};
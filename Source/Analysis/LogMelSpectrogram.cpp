@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    LogMelSpectrogram.cpp
+    Created: 20 Oct 2026 9:41:12am
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#include "LogMelSpectrogram.h"
+
+LogMelSpectrogram::LogMelSpectrogram (const LogMelSettings& newSettings)
+    : settings (newSettings),
+      fftSize (newSettings.getFFTSize()),
+      numBins (newSettings.getFFTSize() / 2 + 1),
+      fft (newSettings.fftOrder)
+{
+    settings.hopLength = jmax (1, settings.hopLength);
+    settings.numMels = jmax (1, settings.numMels);
+
+    window.ensureSize ((size_t) fftSize);
+    for (int i = 0; i < fftSize; ++i)
+        window.data()[i] = (float) (0.5 - 0.5 * std::cos (MathConstants<double>::twoPi * i / fftSize));
+
+    ///The real-only transform works in place on twice the FFT size
+    fftBuffer.ensureSize ((size_t) fftSize * 2);
+    power.ensureSize ((size_t) numBins);
+
+    buildFilters();
+}
+
+void LogMelSpectrogram::buildFilters()
+{
+    auto nyquist = settings.sampleRate * 0.5;
+    auto maxFrequency = settings.maxFrequency > 0.f ? jmin ((double) settings.maxFrequency, nyquist) : nyquist;
+    auto minMel = frequencyToMel (settings.minFrequency);
+    auto maxMel = frequencyToMel (maxFrequency);
+
+    ///numMels triangles over numMels + 2 points evenly spaced in mel
+    std::vector<double> edges ((size_t) settings.numMels + 2);
+    for (size_t i = 0; i < edges.size(); ++i)
+        edges[i] = melToFrequency (minMel + (maxMel - minMel) * (double) i / (double) (edges.size() - 1));
+
+    std::vector<float> allWeights;
+    bands.assign ((size_t) settings.numMels, {});
+
+    for (int m = 0; m < settings.numMels; ++m)
+    {
+        auto lower = edges[(size_t) m], centre = edges[(size_t) m + 1], upper = edges[(size_t) m + 2];
+        auto& band = bands[(size_t) m];
+        band.weightOffset = allWeights.size();
+        band.firstBin = -1;
+
+        for (int bin = 0; bin < numBins; ++bin)
+        {
+            auto frequency = nyquist * bin / (numBins - 1);
+            auto weight = jmax (0.0, jmin ((frequency - lower) / (centre - lower), (upper - frequency) / (upper - centre)));
+
+            if (weight <= 0.0)
+            {
+                if (band.firstBin >= 0)
+                    break;
+                continue;
+            }
+
+            if (band.firstBin < 0)
+                band.firstBin = bin;
+
+            allWeights.push_back ((float) weight);
+        }
+
+        ///Narrower than a bin at low frequencies, the filter stays empty like torchaudio's
+        band.firstBin = jmax (0, band.firstBin);
+        band.numBins = (int) (allWeights.size() - band.weightOffset);
+    }
+
+    weights.ensureSize (jmax ((size_t) 1, allWeights.size()));
+    std::copy (allWeights.begin(), allWeights.end(), weights.data());
+}
+
+int LogMelSpectrogram::getNumFrames (int numSamples) const noexcept
+{
+    return numSamples < fftSize ? 0 : 1 + (numSamples - fftSize) / settings.hopLength;
+}
+
+int LogMelSpectrogram::process (const float* samples, int numSamples, float* output) noexcept
+{
+    auto numFrames = getNumFrames (numSamples);
+
+    for (int frame = 0; frame < numFrames; ++frame)
+        processFrame (samples + (size_t) frame * (size_t) settings.hopLength, output + (size_t) frame * (size_t) settings.numMels);
+
+    return numFrames;
+}
+
+void LogMelSpectrogram::processFrame (const float* frame, float* output) noexcept
+{
+    auto* buffer = fftBuffer.data();
+
+    FloatVectorOperations::multiply (buffer, frame, window.data(), fftSize);
+    fft.performRealOnlyForwardTransform (buffer, true);
+
+    VectorKernels::powerSpectrum (buffer, power.data(), numBins);
+
+    for (int m = 0; m < settings.numMels; ++m)
+    {
+        auto& band = bands[(size_t) m];
+        auto energy = VectorKernels::dotProduct (power.data() + band.firstBin, weights.data() + band.weightOffset, band.numBins);
+        output[m] = std::log (energy + settings.logOffset);
+    }
+}
@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    LogMelSpectrogram.h
+    Created: 20 Oct 2026 9:41:12am
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "AlignedFloatBuffer.h"
+#include "VectorKernels.h"
+
+//==============================================================================
+/** Shape of the log-mel frames, the defaults are the ones of the spectrogram models. */
+struct LogMelSettings
+{
+    double sampleRate = 22050.0;
+
+    ///FFT size is 1 << fftOrder samples, 1024 by default
+    int fftOrder = 10;
+
+    ///Distance between two frame starts, in samples
+    int hopLength = 256;
+
+    int numMels = 64;
+
+    float minFrequency = 0.f;
+
+    ///0 means Nyquist
+    float maxFrequency = 0.f;
+
+    ///Added to the mel power before the log so silence stays finite
+    float logOffset = 1.0e-6f;
+
+    int getFFTSize() const { return 1 << fftOrder; }
+
+    bool operator== (const LogMelSettings& other) const
+    {
+        return sampleRate == other.sampleRate && fftOrder == other.fftOrder && hopLength == other.hopLength
+            && numMels == other.numMels && minFrequency == other.minFrequency
+            && maxFrequency == other.maxFrequency && logOffset == other.logOffset;
+    }
+
+    bool operator!= (const LogMelSettings& other) const { return !operator== (other); }
+};
+
+//==============================================================================
+/**
+    Log-mel spectrogram of a mono signal, the front end of models that take
+    spectrograms rather than raw samples.
+
+    Frames are periodic-Hann windowed and not centred: frame i covers samples
+    [i * hop, i * hop + fftSize). Mel filters are the HTK-scale triangles without
+    normalisation, so the output matches torchaudio's
+    MelSpectrogram (center=False, power=2, mel_scale="htk") followed by log (x + logOffset).
+
+    The power spectrum and the mel projection are vectorised. Each filter only
+    touches the bins under its triangle, so the projection costs about two
+    multiply-adds per bin rather than numMels per bin. Nothing is allocated
+    after construction.
+*/
+class LogMelSpectrogram
+{
+public:
+    explicit LogMelSpectrogram (const LogMelSettings& settings = {});
+
+    const LogMelSettings& getSettings() const noexcept { return settings; }
+
+    int getNumMels() const noexcept { return settings.numMels; }
+
+    ///Whole frames that fit in numSamples, 0 if the signal is shorter than one FFT
+    int getNumFrames (int numSamples) const noexcept;
+
+    /** Writes getNumFrames (numSamples) rows of getNumMels() values, frame after frame.
+        Returns the number of frames written.
+    */
+    int process (const float* samples, int numSamples, float* output) noexcept;
+
+    ///One frame of getSettings().getFFTSize() samples into getNumMels() values
+    void processFrame (const float* frame, float* output) noexcept;
+
+    ///Hz to mel and back, HTK formula
+    static double frequencyToMel (double frequency) { return 2595.0 * std::log10 (1.0 + frequency / 700.0); }
+    static double melToFrequency (double mel)       { return 700.0 * (std::pow (10.0, mel / 2595.0) - 1.0); }
+
+private:
+    void buildFilters();
+
+    ///Contiguous run of non-zero weights of one mel filter
+    struct MelBand
+    {
+        int firstBin = 0;
+        int numBins = 0;
+        size_t weightOffset = 0;
+    };
+
+    LogMelSettings settings;
+    int fftSize = 0;
+    int numBins = 0;
+
+    dsp::FFT fft;
+    AlignedFloatBuffer window;
+    AlignedFloatBuffer fftBuffer;
+    AlignedFloatBuffer power;
+
+    std::vector<MelBand> bands;
+    AlignedFloatBuffer weights;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LogMelSpectrogram)
+};
@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    ModelInputReader.cpp
+    Created: 18 Oct 2026 9:31:12am
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#include "ModelInputReader.h"
+
+ModelInputReader::ModelInputReader (int sizeOfChunks)
+    : chunkSize (jmax (1, sizeOfChunks))
+{
+}
+
+void ModelInputReader::prepareDecodeBuffer (const AudioFormatReader& sourceReader)
+{
+    ///Keeps the allocation when the new file doesn't have more channels
+    decodeBuffer.setSize ((int) jmax (1u, sourceReader.numChannels), chunkSize, false, false, true);
+}
+
+void ModelInputReader::reset (AudioFormatReader& sourceReader, double modelSampleRate, DownmixMode downmixMode)
+{
+    reader = &sourceReader;
+    downmix = downmixMode;
+    readPosition = 0;
+
+    prepareDecodeBuffer (sourceReader);
+    resampler.prepare (sourceReader.sampleRate, modelSampleRate);
+
+    decodedHash = ContentHasher();
+    decodedHash.updateValue (sourceReader.sampleRate);
+}
+
+bool ModelInputReader::readNextBlock (float* destination, int& numSamples)
+{
+    numSamples = 0;
+
+    if (reader == nullptr || readPosition >= reader->lengthInSamples)
+        return false;
+
+    auto numToRead = (int) jmin ((int64) chunkSize, reader->lengthInSamples - readPosition);
+
+    {
+        ScopedStageTimer timer (timings, AnalysisTimingRecord::Decode);
+
+        prepareSection (*reader, readPosition, numToRead);
+        reader->read (&decodeBuffer, 0, numToRead, readPosition, true, true);
+
+        for (int channel = 0; channel < decodeBuffer.getNumChannels(); ++channel)
+            decodedHash.update (decodeBuffer.getReadPointer (channel), (size_t) numToRead * sizeof (float));
+
+        downmixToMono (decodeBuffer.getArrayOfReadPointers(), decodeBuffer.getNumChannels(), numToRead, downmix,
+                       resampler.getInputBuffer (numToRead));
+    }
+
+    readPosition += numToRead;
+
+    ScopedStageTimer timer (timings, AnalysisTimingRecord::Resample);
+    numSamples = resampler.processInputBuffer (numToRead, destination);
+
+    return true;
+}
+
+void ModelInputReader::prepareSection (AudioFormatReader& sourceReader, int64 startSample, int numSamples)
+{
+    auto* mapped = dynamic_cast<MemoryMappedAudioFormatReader*> (&sourceReader);
+    Range<int64> needed (startSample, startSample + numSamples);
+
+    if (mapped == nullptr || mapped->getMappedSection().contains (needed))
+        return;
+
+    ///Unmaps the previous section, pages behind the read position are never needed again
+    auto bytesPerFrame = (int64) jmax (1, (int) sourceReader.numChannels * sourceReader.bitsPerSample / 8);
+    auto sectionLength = jmax ((int64) numSamples, mappedSectionBytes / bytesPerFrame);
+
+    if (!mapped->mapSectionOfFile (needed.withEnd (jmin (sourceReader.lengthInSamples, startSample + sectionLength))))
+        throw std::runtime_error ("Could not map " + mapped->getFile().getFileName().toStdString());
+}
+
+void ModelInputReader::downmixToMono (const float* const* channels, int numChannels, int numSamples,
+                                      DownmixMode mode, float* output)
+{
+    auto numToMix = mode == DownmixMode::FirstChannel ? 1
+                  : mode == DownmixMode::Mid          ? jmin (2, numChannels)
+                                                      : numChannels;
+    numToMix = jmax (1, numToMix);
+
+    if (numToMix == 1)
+    {
+        FloatVectorOperations::copy (output, channels[0], numSamples);
+        return;
+    }
+
+    auto gain = 1.f / (float) numToMix;
+    FloatVectorOperations::multiply (output, channels[0], gain, numSamples);
+
+    for (int channel = 1; channel < numToMix; ++channel)
+        FloatVectorOperations::addWithMultiply (output, channels[channel], gain, numSamples);
+}
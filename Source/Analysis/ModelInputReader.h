@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    ModelInputReader.h
+    Created: 18 Oct 2026 9:31:12am
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "AnalysisResultCache.h"
+#include "AnalysisTimings.h"
+#include "PolyphaseResampler.h"
+
+//==============================================================================
+/**
+    Pulls an audio file chunk by chunk and turns it into mono samples at the
+    model sample rate.
+
+    Only one decoded chunk is held at a time, so the memory used doesn't depend
+    on the length of the file and the classifier can start on the first chunk
+    while the rest of the file is still on disk. The downmix is written straight
+    into the resampler input and the resampler straight into the caller's
+    buffer. Buffers are kept from one file to the next.
+
+    Readers coming from AudioFormat::createMemoryMappedReader() are read through a
+    window of the file mapped just ahead of the read position. The content hash is
+    built from the chunks as they are decoded rather than in a pass of its own, so
+    a first-window analysis only maps the start of the file.
+*/
+class ModelInputReader
+{
+public:
+    explicit ModelInputReader (int chunkSize = defaultChunkSize);
+
+    /** Starts reading a new file, reusing the memory of the previous one. */
+    void reset (AudioFormatReader& sourceReader, double modelSampleRate, DownmixMode downmix = DownmixMode::Mid);
+
+    /** Most samples a readNextBlock() call can write. */
+    int getMaxBlockSize() const { return resampler.getMaxNumOutputSamples (chunkSize); }
+
+    /** Decodes and resamples the next chunk into destination, which must have room
+        for getMaxBlockSize() samples. Returns false at the end of the file.
+    */
+    bool readNextBlock (float* destination, int& numSamples);
+
+    int64 getNumSourceSamplesRead() const { return readPosition; }
+
+    ///Decode and resample time are added to this record, nullptr to stop timing
+    void setTimings (AnalysisTimingRecord* record) noexcept { timings = record; }
+
+    ///Folds numChannels channels into 'mono'
+    static void downmixToMono (const float* const* channels, int numChannels, int numSamples, DownmixMode mode, float* mono);
+
+    /** Hash of the audio decoded since reset(), built by readNextBlock() as it goes. Everything
+        the classifier saw, the whole file or only its start if the analysis needed no more.
+    */
+    const ContentHasher& getDecodedAudioHash() const noexcept { return decodedHash; }
+
+    static constexpr int defaultChunkSize = 16384;
+
+private:
+    void prepareDecodeBuffer (const AudioFormatReader& sourceReader);
+
+    ///Maps the part of the file about to be read when the reader is memory mapped, throws if that fails
+    static void prepareSection (AudioFormatReader& sourceReader, int64 startSample, int numSamples);
+
+    ///Bytes mapped at a time, a few read chunks of a large multichannel file
+    static constexpr int64 mappedSectionBytes = 8 * 1024 * 1024;
+
+    AudioFormatReader* reader = nullptr;
+    DownmixMode downmix = DownmixMode::Mid;
+    const int chunkSize;
+
+    AudioBuffer<float> decodeBuffer;
+
+    ///Keeps its own filter history between chunks
+    PolyphaseResampler resampler { 44100.0, 22050.0 };
+
+    int64 readPosition = 0;
+    ContentHasher decodedHash;
+
+    AnalysisTimingRecord* timings = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ModelInputReader)
+};
@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+
+    PolyphaseResampler.cpp
+    Created: 18 Oct 2026 11:14:47am
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#include "PolyphaseResampler.h"
+
+#include <map>
+#include <numeric>
+
+namespace
+{
+    ///Cutoff (half gain point), as a fraction of the lower Nyquist frequency
+    constexpr double cutoffRatio = 0.9;
+
+    ///About 90 dB of stopband attenuation
+    constexpr double kaiserBeta = 9.0;
+
+    double besselI0 (double x)
+    {
+        double sum = 1.0, term = 1.0;
+        const double halfX = x * 0.5;
+
+        for (int k = 1; k < 64 && term > sum * 1.0e-12; ++k)
+        {
+            term *= (halfX / k) * (halfX / k);
+            sum += term;
+        }
+
+        return sum;
+    }
+
+    std::shared_ptr<const PolyphaseResampler::FilterTable> designFilterTable (int upFactor, int downFactor, int tapsPerPhase)
+    {
+        auto table = std::make_shared<PolyphaseResampler::FilterTable>();
+        table->upFactor = upFactor;
+        table->downFactor = downFactor;
+        table->tapsPerPhase = tapsPerPhase;
+        table->coefficients.resize ((size_t) upFactor * (size_t) tapsPerPhase);
+
+        ///Prototype low-pass at the upsampled rate, cutoff at the lower of the two Nyquist frequencies
+        const int length = upFactor * tapsPerPhase;
+        const double centre = (length - 1) * 0.5;
+        const double cutoff = cutoffRatio * 0.5 / (double) jmax (upFactor, downFactor);
+        const double windowNorm = 1.0 / besselI0 (kaiserBeta);
+
+        std::vector<double> prototype ((size_t) length);
+
+        for (int i = 0; i < length; ++i)
+        {
+            auto x = (i - centre) * 2.0 * cutoff;
+            auto sinc = std::abs (x) < 1.0e-9 ? 1.0 : std::sin (MathConstants<double>::pi * x) / (MathConstants<double>::pi * x);
+            auto position = (2.0 * i) / (length - 1) - 1.0;
+            auto window = besselI0 (kaiserBeta * std::sqrt (jmax (0.0, 1.0 - position * position))) * windowNorm;
+
+            prototype[(size_t) i] = sinc * window;
+        }
+
+        ///Split in phases, reversed so a phase is a plain dot product with the input,
+        ///and normalised one by one so every phase has unity gain at DC
+        for (int phase = 0; phase < upFactor; ++phase)
+        {
+            double sum = 0.0;
+            for (int k = 0; k < tapsPerPhase; ++k)
+                sum += prototype[(size_t) (phase + k * upFactor)];
+
+            auto* row = table->coefficients.data() + (size_t) phase * (size_t) tapsPerPhase;
+            auto gain = std::abs (sum) > 1.0e-12 ? 1.0 / sum : 0.0;
+
+            for (int k = 0; k < tapsPerPhase; ++k)
+                row[tapsPerPhase - 1 - k] = (float) (prototype[(size_t) (phase + k * upFactor)] * gain);
+        }
+
+        return table;
+    }
+}
+
+//==============================================================================
+std::shared_ptr<const PolyphaseResampler::FilterTable> PolyphaseResampler::getFilterTable (int upFactor, int downFactor, int tapsPerPhase)
+{
+    ///Tables are small (a few hundred kB at worst) and there are only a handful of source rates, so they are kept for the process lifetime
+    static CriticalSection lock;
+    static std::map<std::tuple<int, int, int>, std::shared_ptr<const FilterTable>> tables;
+
+    const ScopedLock sl (lock);
+
+    auto& table = tables[{ upFactor, downFactor, tapsPerPhase }];
+
+    if (table == nullptr)
+        table = designFilterTable (upFactor, downFactor, tapsPerPhase);
+
+    return table;
+}
+
+PolyphaseResampler::PolyphaseResampler (double sourceRate, double targetRate, int zeroCrossings)
+{
+    prepare (sourceRate, targetRate, zeroCrossings);
+}
+
+void PolyphaseResampler::prepare (double sourceRate, double targetRate, int zeroCrossings)
+{
+    jassert (sourceRate > 0 && targetRate > 0);
+
+    auto source = jmax (1, roundToInt (sourceRate));
+    auto target = jmax (1, roundToInt (targetRate));
+    auto divisor = std::gcd (source, target);
+
+    auto up = target / divisor;
+    auto down = source / divisor;
+
+    ///Unusual rates (e.g. 44099 Hz) would need thousands of phases, a tiny ratio error is fine for analysis
+    if (up > maxPhases)
+    {
+        down = jmax (1, roundToInt ((double) maxPhases * sourceRate / targetRate));
+        up = maxPhases;
+        divisor = std::gcd (up, down);
+        up /= divisor;
+        down /= divisor;
+    }
+
+    ///Enough taps to keep zeroCrossings lobes at the lower rate, rounded up for the vector kernel
+    auto taps = (int) std::ceil (2.0 * jmax (1, zeroCrossings) * jmax (1.0, (double) down / (double) up));
+    taps = (taps + 7) & ~7;
+
+    table = getFilterTable (up, down, taps);
+    reset();
+}
+
+void PolyphaseResampler::reset()
+{
+    const int taps = table->tapsPerPhase;
+
+    if (buffer.size() < (size_t) taps * 2)
+        buffer.resize ((size_t) taps * 2);
+
+    std::fill (buffer.begin(), buffer.begin() + taps - 1, 0.f);
+    numInBuffer = taps - 1;
+
+    ///Start half a filter later so the filter delay is compensated
+    nextTime = (int64) (taps - 1) * table->upFactor + ((int64) table->upFactor * taps - 1) / 2;
+}
+
+int PolyphaseResampler::getMaxNumOutputSamples (int numInput) const
+{
+    return (int) (((int64) numInput + 1) * table->upFactor / table->downFactor) + 1;
+}
+
+int PolyphaseResampler::process (const float* input, int numInput, float* output)
+{
+    FloatVectorOperations::copy (getInputBuffer (numInput), input, numInput);
+    return processInputBuffer (numInput, output);
+}
+
+float* PolyphaseResampler::getInputBuffer (int numInput)
+{
+    ///Grows once for the biggest call, then stays
+    if (buffer.size() < (size_t) (numInBuffer + numInput))
+        buffer.resize ((size_t) (numInBuffer + numInput));
+
+    return buffer.data() + numInBuffer;
+}
+
+int PolyphaseResampler::processInputBuffer (int numInput, float* output)
+{
+    const auto& filter = *table;
+    const int taps = filter.tapsPerPhase;
+    const int up = filter.upFactor;
+    const int down = filter.downFactor;
+
+    jassert ((size_t) (numInBuffer + numInput) <= buffer.size());
+    numInBuffer += numInput;
+
+    int numOut = 0;
+
+    for (;;)
+    {
+        auto newest = nextTime / up;
+
+        if (newest >= numInBuffer)
+            break;
+
+        auto phase = (int) (nextTime - newest * up);
+        output[numOut++] = VectorKernels::dotProduct (filter.getPhase (phase), buffer.data() + newest - (taps - 1), taps);
+        nextTime += down;
+    }
+
+    ///Drop what the next output won't read anymore
+    auto numToDrop = (int) jmin ((int64) numInBuffer, nextTime / up - (taps - 1));
+
+    if (numToDrop > 0)
+    {
+        numInBuffer -= numToDrop;
+        std::memmove (buffer.data(), buffer.data() + numToDrop, (size_t) numInBuffer * sizeof (float));
+        nextTime -= (int64) numToDrop * up;
+    }
+
+    return numOut;
+}
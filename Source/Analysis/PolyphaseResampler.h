@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    PolyphaseResampler.h
+    Created: 18 Oct 2026 11:14:47am
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "VectorKernels.h"
+
+//==============================================================================
+/**
+    Streaming rational resampler using a Kaiser-windowed sinc split in polyphase
+    sub-filters.
+
+    The conversion ratio is reduced to L/M (22050/44100 = 1/2, 22050/48000 =
+    147/320, ...). Each output sample is one dot product between a sub-filter and
+    the last input samples, so the cost per output sample is getTapsPerPhase()
+    multiply adds whatever the phase. Filter tables only depend on the rates and
+    are shared by every resampler of the process.
+
+    The filter keeps zeroCrossings sinc lobes on each side at the lower of the two
+    rates, so downsampling from a higher rate uses proportionally more taps.
+
+    The group delay of the filter is compensated: output sample n is aligned with
+    input time n * sourceRate / targetRate. The very end of the stream (half a
+    filter length) is not flushed.
+*/
+class PolyphaseResampler
+{
+public:
+    PolyphaseResampler (double sourceRate, double targetRate, int zeroCrossings = defaultZeroCrossings);
+
+    /** Switches to other rates and resets, keeping the memory already allocated. */
+    void prepare (double sourceRate, double targetRate, int zeroCrossings = defaultZeroCrossings);
+
+    void reset();
+
+    /** Consumes every input sample and writes the output samples they complete.
+        output must hold getMaxNumOutputSamples (numInput) samples.
+        Returns the number of samples written.
+    */
+    int process (const float* input, int numInput, float* output);
+
+    /** Room for the next numInput input samples, so a caller can produce them in place
+        (e.g. a downmix) instead of copying them in. Follow with processInputBuffer().
+    */
+    float* getInputBuffer (int numInput);
+
+    /** Same as process() for samples written with getInputBuffer(). */
+    int processInputBuffer (int numInput, float* output);
+
+    int getMaxNumOutputSamples (int numInput) const;
+
+    int getUpFactor() const      { return table->upFactor; }
+    int getDownFactor() const    { return table->downFactor; }
+    int getTapsPerPhase() const  { return table->tapsPerPhase; }
+
+    static constexpr int defaultZeroCrossings = 16;
+
+    ///Biggest number of phases used, unusual ratios are approximated to stay below it
+    static constexpr int maxPhases = 640;
+
+    struct FilterTable
+    {
+        int upFactor = 1;
+        int downFactor = 1;
+        int tapsPerPhase = 0;
+
+        ///upFactor rows of tapsPerPhase coefficients, each row reversed so it lines up with the input
+        std::vector<float> coefficients;
+
+        const float* getPhase (int phase) const { return coefficients.data() + (size_t) phase * (size_t) tapsPerPhase; }
+    };
+
+    static std::shared_ptr<const FilterTable> getFilterTable (int upFactor, int downFactor, int tapsPerPhase);
+
+private:
+    std::shared_ptr<const FilterTable> table;
+
+    ///Last tapsPerPhase - 1 samples followed by the samples of the current call
+    std::vector<float> buffer;
+    int numInBuffer = 0;
+
+    ///Time of the next output, in upsampled samples, relative to buffer[0]
+    int64 nextTime = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PolyphaseResampler)
+};
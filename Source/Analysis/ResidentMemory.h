@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    ResidentMemory.h
+    Created: 17 Oct 2026 2:21:05pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CustomJuceHeader.h"
+
+#if JUCE_LINUX
+ #include <cstdio>
+ #include <unistd.h>
+#elif JUCE_MAC
+ #include <mach/mach.h>
+#endif
+
+///Resident set size of the whole process in bytes, 0 if the platform isn't supported
+inline int64 getResidentMemoryBytes()
+{
+   #if JUCE_LINUX
+    int64 totalPages = 0, residentPages = 0;
+
+    if (auto* statm = fopen ("/proc/self/statm", "r"))
+    {
+        if (fscanf (statm, "%lld %lld", &totalPages, &residentPages) != 2)
+            residentPages = 0;
+        fclose (statm);
+    }
+
+    return residentPages * (int64) sysconf (_SC_PAGESIZE);
+   #elif JUCE_MAC
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+
+    if (task_info (mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t) &info, &count) != KERN_SUCCESS)
+        return 0;
+
+    return (int64) info.resident_size;
+   #else
+    return 0;
+   #endif
+}
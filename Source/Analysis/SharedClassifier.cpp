@@ -0,0 +1,346 @@
+/*
+  ==============================================================================
+
+    SharedClassifier.cpp
+    Created: 17 Oct 2026 2:21:05pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#include "SharedClassifier.h"
+#include "AnalysisResultCache.h"
+#include "CompactBackend.h"
+
+#if AUTOEFFECT_WITH_LIBTORCH
+ #include "TorchBackend.h"
+#endif
+
+#include <BinaryData.h>
+
+namespace
+{
+    ///Registry of the process, only holds weak references so the last instance frees the weights
+    CriticalSection registryLock;
+    std::weak_ptr<SharedClassifier> registry[2];
+    std::atomic<int> numLoadedModels { 0 };
+
+    ///Bumped when the external file of a variant changes, models of an older generation are outdated
+    std::atomic<int> generations[2];
+    File modelDirectory;
+
+    const char* getModelData (ModelVariant variant, int& size)
+    {
+        size = 0;
+
+       #if AUTOEFFECT_WITH_LIBTORCH
+        return BinaryData::getNamedResource (variant == ModelVariant::Int8 ? "classifier_int8_pt" : "classifier_pt", size);
+       #else
+        return variant == ModelVariant::Int8 ? nullptr : BinaryData::getNamedResource ("classifier_aenet", size);
+       #endif
+    }
+
+    ///Path, size and date of the file, empty if there is no such file
+    String getFileState (const File& file)
+    {
+        if (!file.existsAsFile())
+            return {};
+
+        return file.getFullPathName() + "|" + String (file.getSize()) + "|" + String (file.getLastModificationTime().toMilliseconds());
+    }
+}
+
+SharedClassifier::Ptr SharedClassifier::acquire (ModelVariant variant, int warmUpLength, bool* loadedByThisCall)
+{
+    ///Held during the load so a second instance waits for the first one instead of loading its own copy
+    const ScopedLock sl (registryLock);
+
+    if (loadedByThisCall != nullptr)
+        *loadedByThisCall = false;
+
+    auto& slot = registry[(size_t) variant];
+
+    ///An outdated model stays alive for whoever still holds it, it just isn't handed out anymore
+    if (auto existing = slot.lock())
+        if (!existing->isOutdated())
+            return existing;
+
+    if (loadedByThisCall != nullptr)
+        *loadedByThisCall = true;
+
+    ///Taken before the load, a file replaced meanwhile is seen by the next check
+    auto externalFile = getExternalModelFile (variant);
+    auto fileState = getFileState (externalFile);
+    auto generation = generations[(size_t) variant].load();
+
+    Ptr classifier;
+
+    if (fileState.isNotEmpty())
+    {
+        try
+        {
+            classifier.reset (new SharedClassifier (variant, warmUpLength, externalFile));
+        }
+        catch (const std::exception& e)
+        {
+            Logger::writeToLog ("Could not load " + externalFile.getFullPathName() + ", using the embedded model: " + e.what());
+        }
+    }
+
+    if (classifier == nullptr)
+        classifier.reset (new SharedClassifier (variant, warmUpLength, File()));
+
+    ///A rejected file keeps its state too, so it isn't retried until it changes again
+    classifier->fileState = fileState;
+    classifier->generation = generation;
+
+    slot = classifier;
+    return classifier;
+}
+
+bool SharedClassifier::isVariantAvailable (ModelVariant variant)
+{
+   #if !AUTOEFFECT_WITH_LIBTORCH
+    if (variant == ModelVariant::Int8)
+        return false;
+   #endif
+
+    int size = 0;
+    return (getModelData (variant, size) != nullptr && size > 0) || getExternalModelFile (variant).existsAsFile();
+}
+
+File SharedClassifier::getModelDirectory()
+{
+    const ScopedLock sl (registryLock);
+
+    if (modelDirectory != File())
+        return modelDirectory;
+
+    return File::getSpecialLocation (File::userApplicationDataDirectory)
+          #if JUCE_MAC
+           .getChildFile ("Application Support")
+          #endif
+           .getChildFile ("AutoEffect")
+           .getChildFile ("Models");
+}
+
+void SharedClassifier::setModelDirectory (const File& newDirectory)
+{
+    const ScopedLock sl (registryLock);
+    modelDirectory = newDirectory;
+}
+
+File SharedClassifier::getExternalModelFile (ModelVariant variant)
+{
+    auto directory = getModelDirectory();
+
+    if (variant == ModelVariant::Int8)
+        return directory.getChildFile ("classifier_int8.pt");
+
+    auto compact = directory.getChildFile ("classifier.aenet");
+
+   #if AUTOEFFECT_WITH_LIBTORCH
+    auto torchScript = directory.getChildFile ("classifier.pt");
+    return torchScript.existsAsFile() || !compact.existsAsFile() ? torchScript : compact;
+   #else
+    return compact;
+   #endif
+}
+
+void SharedClassifier::checkForModelUpdates()
+{
+    ///Somebody is loading a model, it will see the current files anyway
+    const ScopedTryLock sl (registryLock);
+    if (!sl.isLocked())
+        return;
+
+    for (auto variant : { ModelVariant::Float32, ModelVariant::Int8 })
+    {
+        auto live = registry[(size_t) variant].lock();
+
+        if (live == nullptr || live->isOutdated() || live->fileState == getFileState (getExternalModelFile (variant)))
+            continue;
+
+        Logger::writeToLog ("The " + getVariantName (variant) + " model file changed, reloading before the next analysis");
+        ++generations[(size_t) variant];
+    }
+}
+
+String SharedClassifier::checkModelMetadata (const String& metadataJSON)
+{
+    if (metadataJSON.isEmpty())
+        return "no " + String (modelMetadataFileName) + " in the model archive";
+
+    auto metadata = JSON::parse (metadataJSON);
+    if (!metadata.isObject())
+        return String (modelMetadataFileName) + " is not a JSON object";
+
+    auto formatVersion = (int) metadata.getProperty ("formatVersion", 0);
+    if (formatVersion != supportedModelFormatVersion)
+        return "model format version " + String (formatVersion) + ", this build reads version " + String (supportedModelFormatVersion);
+
+    auto numClasses = (int) metadata.getProperty ("numClasses", 0);
+    if (numClasses != numberOfEffects)
+        return "the model has " + String (numClasses) + " classes, " + String (numberOfEffects) + " expected";
+
+    auto input = metadata.getProperty ("input", "waveform").toString();
+
+    if (input == "logmel")
+    {
+        auto fftSize = (int) metadata.getProperty ("fftSize", 1024);
+        if (fftSize < 16 || !isPowerOfTwo (fftSize))
+            return "fftSize " + String (fftSize) + " is not a power of two";
+
+        if ((int) metadata.getProperty ("numMels", 64) <= 0 || (int) metadata.getProperty ("melHopLength", 256) <= 0)
+            return "numMels and melHopLength must be positive";
+    }
+    else if (input != "waveform")
+    {
+        return "unknown model input \"" + input + "\"";
+    }
+
+    return {};
+}
+
+bool SharedClassifier::readLogMelInput (const var& metadata, LogMelSettings& settings)
+{
+    if (metadata.getProperty ("input", "waveform").toString() != "logmel")
+        return false;
+
+    settings = {};
+    settings.sampleRate   = (double) metadata.getProperty ("sampleRate", settings.sampleRate);
+    settings.fftOrder     = roundToInt (std::log2 ((double) (int) metadata.getProperty ("fftSize", settings.getFFTSize())));
+    settings.hopLength    = (int) metadata.getProperty ("melHopLength", settings.hopLength);
+    settings.numMels      = (int) metadata.getProperty ("numMels", settings.numMels);
+    settings.minFrequency = (float) metadata.getProperty ("minFrequency", settings.minFrequency);
+    settings.maxFrequency = (float) metadata.getProperty ("maxFrequency", settings.maxFrequency);
+    settings.logOffset    = (float) metadata.getProperty ("logOffset", settings.logOffset);
+    return true;
+}
+
+bool SharedClassifier::isOutdated() const
+{
+    return generation != generations[(size_t) variant].load();
+}
+
+int SharedClassifier::getNumLoadedModels()
+{
+    return numLoadedModels.load();
+}
+
+SharedClassifier::SharedClassifier (ModelVariant modelVariant, int warmUpLength, const File& externalFile)
+    : variant (modelVariant), sourceFile (externalFile)
+{
+    auto startTime = Time::getMillisecondCounterHiRes();
+
+    if (sourceFile != File())
+    {
+        mappedFile.reset (new MemoryMappedFile (sourceFile, MemoryMappedFile::readOnly));
+
+        if (mappedFile->getData() == nullptr)
+            throw std::runtime_error ("could not map the file");
+
+        load (static_cast<const char*> (mappedFile->getData()), mappedFile->getSize(), true);
+
+        ///libtorch copied the weights out, the mapping is only kept for backends reading them in place
+        if (!backend->readsWeightsInPlace())
+            mappedFile.reset();
+    }
+    else
+    {
+        int length = 0;
+        const char* data = getModelData (variant, length);
+
+        if (data == nullptr || length <= 0)
+            throw std::runtime_error ("No " + getVariantName (variant).toStdString() + " classifier in this build");
+
+        load (data, (size_t) length, false);
+    }
+
+    auto loadedTime = Time::getMillisecondCounterHiRes();
+    loadMs = loadedTime - startTime;
+
+    ///First forward pass allocates and optimises everything, do it now on silence rather than on the user's file
+    ClassifierInput silence;
+    silence.isSpectrogram = logMelInput;
+    silence.numFrames = logMelInput ? LogMelSpectrogram (logMelSettings).getNumFrames (warmUpLength) : warmUpLength;
+    silence.numChannels = logMelInput ? logMelSettings.numMels : 1;
+    silence.rowStride = (int64) silence.numFrames * silence.numChannels;
+
+    std::vector<float> zeros ((size_t) silence.rowStride, 0.f);
+    silence.data = zeros.data();
+
+    std::vector<float> output;
+    forward (silence, output);
+
+    if (sourceFile != File() && output.size() != (size_t) numberOfEffects)
+        throw std::runtime_error ("the model returns " + std::to_string (output.size()) + " scores per window, "
+                                  + std::to_string (numberOfEffects) + " expected");
+
+    warmUpMs = Time::getMillisecondCounterHiRes() - loadedTime;
+
+    ++numLoadedModels;
+}
+
+SharedClassifier::~SharedClassifier()
+{
+    --numLoadedModels;
+}
+
+void SharedClassifier::load (const char* data, size_t size, bool checkMetadata)
+{
+    ContentHasher modelHash;
+    modelHash.update (data, size);
+    modelId = modelHash.toHexString();
+
+    auto isCompact = CompactBackend::isCompactModel (data, size);
+
+    ///Compact models always carry their metadata, embedded TorchScript archives don't need any
+    String metadata;
+
+    if (isCompact)
+        metadata = CompactBackend::readMetadata (data, size);
+   #if AUTOEFFECT_WITH_LIBTORCH
+    else if (checkMetadata)
+        metadata = TorchBackend::readMetadata (data, size, modelMetadataFileName);
+   #endif
+
+    ///Checked before the load, a model from another version may not even deserialise
+    if (checkMetadata || metadata.isNotEmpty())
+    {
+        auto error = checkModelMetadata (metadata);
+        if (error.isNotEmpty())
+            throw std::runtime_error (error.toStdString());
+
+        logMelInput = readLogMelInput (JSON::parse (metadata), logMelSettings);
+    }
+
+    if (isCompact)
+    {
+        backend.reset (new CompactBackend (data, size));
+        return;
+    }
+
+   #if AUTOEFFECT_WITH_LIBTORCH
+    backend = TorchBackend::create (data, size, variant == ModelVariant::Int8);
+   #else
+    throw std::runtime_error ("this build has no libtorch backend, only compact models can be loaded");
+   #endif
+}
+
+void SharedClassifier::forward (const ClassifierInput& input, std::vector<float>& output)
+{
+    if (serialiseForwardCalls)
+    {
+        const ScopedLock sl (inferenceLock);
+        runForward (input, output);
+        return;
+    }
+
+    runForward (input, output);
+}
+
+void SharedClassifier::runForward (const ClassifierInput& input, std::vector<float>& output)
+{
+    backend->forward (input, output, numInferenceThreads.load());
+}
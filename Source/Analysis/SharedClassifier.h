@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+
+    SharedClassifier.h
+    Created: 17 Oct 2026 2:21:05pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CustomJuceHeader.h"
+#include "ClassifierBackend.h"
+#include "LogMelSpectrogram.h"
+
+//==============================================================================
+/** Embedded models, the int8 one is only there if Ressources/classifier_int8.pt existed at build time.
+    Builds without libtorch embed Ressources/classifier.aenet instead, a compact model, and have no int8 variant.
+    Either can be replaced by a file of the same name in SharedClassifier::getModelDirectory().
+*/
+enum class ModelVariant
+{
+    Float32 = 0,    ///< Ressources/classifier.pt, or Ressources/classifier.aenet without libtorch
+    Int8            ///< Dynamic-quantised copy made by Scripts/quantize_classifier.py
+};
+
+//==============================================================================
+/**
+    The classifier shared by every plugin instance of the process.
+
+    acquire() hands out the same object (one per variant) to everybody as long as
+    one instance holds it, the weights are freed when the last Ptr goes away. Models are only
+    used for read-only inference, calls to forward() are serialised so that
+    instances analysing at the same time don't fight for libtorch scratch memory.
+
+    The model data decides the backend: TorchScript archives run on libtorch, compact
+    models (Scripts/export_compact_classifier.py) on the dependency-free CompactBackend.
+
+    A model file dropped in getModelDirectory() takes precedence over the embedded one,
+    provided its metadata passes the version check. A classifier never changes once
+    loaded: when the file changes, checkForModelUpdates() marks the live models as
+    outdated and the next acquire() loads a new one, while holders of the old Ptr
+    finish their inferences on the old module.
+*/
+class SharedClassifier
+{
+public:
+    using Ptr = std::shared_ptr<SharedClassifier>;
+
+    /** Returns the process-wide classifier, loading and warming it up if needed.
+        This blocks while the model loads, call it from a background thread.
+        An external model that can't be loaded is logged and the embedded one is used instead.
+        Throws if the embedded model can't be loaded either. If given, loadedByThisCall tells
+        whether this call paid for the load or reused the model of another instance.
+    */
+    static Ptr acquire (ModelVariant variant, int warmUpLength, bool* loadedByThisCall = nullptr);
+
+    ///False when the build doesn't embed that variant and there is no external file for it
+    static bool isVariantAvailable (ModelVariant variant);
+
+    //==============================================================================
+    /** Where external models are looked for, classifier.pt, classifier.aenet and classifier_int8.pt.
+        Defaults to the AutoEffect/Models folder of the user application data.
+    */
+    static File getModelDirectory();
+    static void setModelDirectory (const File& newDirectory);
+
+    ///The file looked for, classifier.pt is preferred to classifier.aenet when both exist and libtorch is built
+    static File getExternalModelFile (ModelVariant variant);
+
+    /** Compares the external model files with the ones the live models were loaded from,
+        and marks every live model as outdated if one was added, replaced or removed.
+        Only a few file system queries, meant to be called before each analysis.
+    */
+    static void checkForModelUpdates();
+
+    /** Version of the metadata external models must carry, stored as the extra file
+        modelMetadataFileName of the TorchScript archive (see Scripts/package_classifier.py).
+    */
+    static constexpr int supportedModelFormatVersion = 1;
+    static constexpr const char* modelMetadataFileName = "autoeffect.json";
+
+    ///Empty if the metadata describes a model this build can use, otherwise the reason why not
+    static String checkModelMetadata (const String& metadataJSON);
+
+    /** True for models whose metadata has "input": "logmel". They take [windows, frames, mels]
+        log-mel tensors computed by LogMelSpectrogram instead of [windows, samples].
+    */
+    static bool readLogMelInput (const var& metadata, LogMelSettings& settings);
+
+    static String getVariantName (ModelVariant variant) { return variant == ModelVariant::Int8 ? "int8" : "fp32"; }
+
+    ///Number of live models in the process, at most one per variant
+    static int getNumLoadedModels();
+
+    ///Values returned by the model for every row of the input, see ClassifierBackend::forward
+    void forward (const ClassifierInput& input, std::vector<float>& output);
+
+    ///"libtorch" or "compact"
+    String getBackendName() const { return backend->getName(); }
+
+    /** Intra-op threads used by libtorch for the next forward calls.
+        This is a process-wide libtorch setting, the last instance to set it wins.
+    */
+    void setNumInferenceThreads (int numThreads) { numInferenceThreads = jmax (1, numThreads); }
+
+    /** On by default. Batch tools running one analysis per core turn it off and give
+        each call a single intra-op thread instead, inference itself is read-only.
+    */
+    void setSerialiseForwardCalls (bool shouldSerialise) { serialiseForwardCalls = shouldSerialise; }
+
+    ///Hash of the model weights, changes whenever a different model is shipped
+    const String& getModelId() const { return modelId; }
+
+    ModelVariant getVariant() const { return variant; }
+
+    ///The external file the model was read from, or File() for the embedded model
+    const File& getSourceFile() const { return sourceFile; }
+
+    ///True once a newer model is available, the next acquire() returns it
+    bool isOutdated() const;
+
+    ///Set for spectrogram-input models, the embedded models take raw samples
+    bool takesLogMel() const { return logMelInput; }
+    const LogMelSettings& getLogMelSettings() const { return logMelSettings; }
+
+    double getLoadMs() const   { return loadMs; }
+    double getWarmUpMs() const { return warmUpMs; }
+
+    ~SharedClassifier();
+
+private:
+    SharedClassifier (ModelVariant variant, int warmUpLength, const File& externalFile);
+
+    void load (const char* data, size_t size, bool checkMetadata);
+    void runForward (const ClassifierInput& input, std::vector<float>& output);
+
+    const ModelVariant variant;
+    File sourceFile;
+    String fileState;
+    int generation = 0;
+
+    ///Kept as long as the backend reads its weights from it
+    std::unique_ptr<MemoryMappedFile> mappedFile;
+    std::unique_ptr<ClassifierBackend> backend;
+    CriticalSection inferenceLock;
+    std::atomic<int> numInferenceThreads { 1 };
+    std::atomic<bool> serialiseForwardCalls { true };
+
+    bool logMelInput = false;
+    LogMelSettings logMelSettings;
+
+    String modelId;
+    double loadMs = 0.0;
+    double warmUpMs = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedClassifier)
+};
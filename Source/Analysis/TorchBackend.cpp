@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    TorchBackend.cpp
+    Created: 20 Oct 2026 2:37:50pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#include "TorchBackend.h"
+
+#include <torch/script.h>
+#include <caffe2/serialize/inline_container.h>
+
+namespace
+{
+    ///Quantised kernels need an engine, FBGEMM on x86 and QNNPACK on ARM
+    void selectQuantisedEngine()
+    {
+        const auto& engines = at::globalContext().supportedQEngines();
+
+        for (auto engine : { at::QEngine::FBGEMM, at::QEngine::QNNPACK })
+        {
+            if (std::find (engines.begin(), engines.end(), engine) != engines.end())
+            {
+                at::globalContext().setQEngine (engine);
+                return;
+            }
+        }
+
+        throw std::runtime_error ("libtorch was built without a quantised engine");
+    }
+
+    ///Lets libtorch read an archive where it already is in memory, embedded data or a mapped file
+    class MemoryReadAdapter : public caffe2::serialize::ReadAdapterInterface
+    {
+    public:
+        MemoryReadAdapter (const char* dataToRead, size_t dataSize) : data (dataToRead), numBytes (dataSize) {}
+
+        size_t size() const override { return numBytes; }
+
+        size_t read (uint64_t pos, void* buf, size_t n, const char*) const override
+        {
+            if (pos >= numBytes)
+                return 0;
+
+            n = std::min (n, (size_t) (numBytes - pos));
+            std::memcpy (buf, data + pos, n);
+            return n;
+        }
+
+    private:
+        const char* data;
+        size_t numBytes;
+    };
+
+    class TorchScriptModel : public ClassifierBackend
+    {
+    public:
+        TorchScriptModel (const char* data, size_t size)
+        {
+            ///Read in place, the archive is never copied into a string or a stream buffer
+            module = torch::jit::load (std::make_shared<MemoryReadAdapter> (data, size));
+            module.eval();
+        }
+
+        String getName() const override { return "libtorch"; }
+
+        bool readsWeightsInPlace() const override { return false; }
+
+        void forward (const ClassifierInput& input, std::vector<float>& output, int numThreads) override
+        {
+            torch::NoGradGuard noGrad;
+
+            if (at::get_num_threads() != numThreads)
+                at::set_num_threads (numThreads);
+
+            ///Overlapping rows of the same memory, nothing is copied on our side
+            auto* data = const_cast<float*> (input.data);
+            auto tensor = input.isSpectrogram
+                        ? torch::from_blob (data, { input.numRows, input.numFrames, input.numChannels },
+                                            { input.rowStride, input.numChannels, 1 }, torch::kFloat)
+                        : torch::from_blob (data, { input.numRows, input.numFrames }, { input.rowStride, 1 }, torch::kFloat);
+
+            std::vector<torch::jit::IValue> inputs;
+            inputs.push_back (tensor);
+
+            auto result = module.forward (inputs).toTensor();
+
+            if (input.numRows > 1 && (result.dim() == 0 || result.size (0) != input.numRows))
+                throw std::runtime_error ("the model did not return one row per window");
+
+            auto values = result.to (torch::kFloat).contiguous();
+            auto* first = values.data_ptr<float>();
+            output.assign (first, first + values.numel());
+        }
+
+    private:
+        torch::jit::script::Module module;
+    };
+}
+
+String TorchBackend::readMetadata (const char* data, size_t size, const char* extraFileName)
+{
+    caffe2::serialize::PyTorchStreamReader archive (std::make_shared<MemoryReadAdapter> (data, size));
+    auto record = std::string ("extra/") + extraFileName;
+
+    if (!archive.hasRecord (record))
+        return {};
+
+    auto content = archive.getRecord (record);
+    return String::fromUTF8 (static_cast<const char*> (std::get<0> (content).get()), (int) std::get<1> (content));
+}
+
+std::unique_ptr<ClassifierBackend> TorchBackend::create (const char* data, size_t size, bool isQuantised)
+{
+    ///Inter-op parallelism is useless for this single-path model and can only be set before the first use
+    static bool interOpConfigured = false;
+    if (!interOpConfigured)
+    {
+        interOpConfigured = true;
+        try { at::set_num_interop_threads (1); }
+        catch (const std::exception&) {}
+    }
+
+    if (isQuantised)
+        selectQuantisedEngine();
+
+    return std::make_unique<TorchScriptModel> (data, size);
+}
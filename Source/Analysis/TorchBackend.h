@@ -0,0 +1,29 @@
+/*
+  ==============================================================================
+
+    TorchBackend.h
+    Created: 20 Oct 2026 2:37:50pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ClassifierBackend.h"
+
+//==============================================================================
+/**
+    TorchScript models run by libtorch, only built with AUTOEFFECT_WITH_LIBTORCH.
+
+    The archive is read in place through a read adapter, libtorch copies the weights
+    out so the data can be released once create() returns.
+*/
+namespace TorchBackend
+{
+    ///The extra file of that name in the archive, empty if there is none
+    String readMetadata (const char* data, size_t size, const char* extraFileName);
+
+    ///Throws if the archive can't be loaded. Quantised models need a quantised engine, selected here
+    std::unique_ptr<ClassifierBackend> create (const char* data, size_t size, bool isQuantised);
+}
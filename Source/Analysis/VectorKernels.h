@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+    VectorKernels.h
+    Created: 18 Oct 2026 11:14:47am
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CustomJuceHeader.h"
+
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define AUTOEFFECT_USE_SSE 1
+ #include <immintrin.h>
+#elif defined (__ARM_NEON) || defined (__ARM_NEON__) || defined (_M_ARM64)
+ #define AUTOEFFECT_USE_NEON 1
+ #include <arm_neon.h>
+#endif
+
+//==============================================================================
+/**
+    Small hand-vectorised kernels for the analysis front end.
+
+    FloatVectorOperations covers element-wise work, these cover the reductions
+    it doesn't have. Pointers don't need to be aligned.
+*/
+namespace VectorKernels
+{
+    inline float dotProduct (const float* a, const float* b, int num) noexcept
+    {
+        int i = 0;
+        float sum = 0.f;
+
+       #if AUTOEFFECT_USE_SSE
+        auto acc0 = _mm_setzero_ps();
+        auto acc1 = _mm_setzero_ps();
+
+        for (; i + 8 <= num; i += 8)
+        {
+            acc0 = _mm_add_ps (acc0, _mm_mul_ps (_mm_loadu_ps (a + i),     _mm_loadu_ps (b + i)));
+            acc1 = _mm_add_ps (acc1, _mm_mul_ps (_mm_loadu_ps (a + i + 4), _mm_loadu_ps (b + i + 4)));
+        }
+
+        alignas (16) float lanes[4];
+        _mm_store_ps (lanes, _mm_add_ps (acc0, acc1));
+        sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+       #elif AUTOEFFECT_USE_NEON
+        auto acc0 = vdupq_n_f32 (0.f);
+        auto acc1 = vdupq_n_f32 (0.f);
+
+        for (; i + 8 <= num; i += 8)
+        {
+            acc0 = vmlaq_f32 (acc0, vld1q_f32 (a + i),     vld1q_f32 (b + i));
+            acc1 = vmlaq_f32 (acc1, vld1q_f32 (a + i + 4), vld1q_f32 (b + i + 4));
+        }
+
+        auto acc = vaddq_f32 (acc0, acc1);
+        sum = (vgetq_lane_f32 (acc, 0) + vgetq_lane_f32 (acc, 1)) + (vgetq_lane_f32 (acc, 2) + vgetq_lane_f32 (acc, 3));
+       #endif
+
+        for (; i < num; ++i)
+            sum += a[i] * b[i];
+
+        return sum;
+    }
+
+    ///re * re + im * im of numBins interleaved complex values, as dsp::FFT real transforms write them
+    inline void powerSpectrum (const float* interleaved, float* power, int numBins) noexcept
+    {
+        int i = 0;
+
+       #if AUTOEFFECT_USE_SSE
+        for (; i + 4 <= numBins; i += 4)
+        {
+            auto lo = _mm_loadu_ps (interleaved + 2 * i);
+            auto hi = _mm_loadu_ps (interleaved + 2 * i + 4);
+            lo = _mm_mul_ps (lo, lo);
+            hi = _mm_mul_ps (hi, hi);
+
+            auto re = _mm_shuffle_ps (lo, hi, _MM_SHUFFLE (2, 0, 2, 0));
+            auto im = _mm_shuffle_ps (lo, hi, _MM_SHUFFLE (3, 1, 3, 1));
+            _mm_storeu_ps (power + i, _mm_add_ps (re, im));
+        }
+       #elif AUTOEFFECT_USE_NEON
+        for (; i + 4 <= numBins; i += 4)
+        {
+            auto bins = vld2q_f32 (interleaved + 2 * i);
+            vst1q_f32 (power + i, vmlaq_f32 (vmulq_f32 (bins.val[0], bins.val[0]), bins.val[1], bins.val[1]));
+        }
+       #endif
+
+        for (; i < numBins; ++i)
+            power[i] = interleaved[2 * i] * interleaved[2 * i] + interleaved[2 * i + 1] * interleaved[2 * i + 1];
+    }
+}
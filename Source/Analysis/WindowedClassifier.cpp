@@ -0,0 +1,285 @@
+/*
+  ==============================================================================
+
+    WindowedClassifier.cpp
+    Created: 17 Oct 2026 11:02:18am
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#include "WindowedClassifier.h"
+
+int WindowedClassifier::getNumWindows (int numSamples, const AnalysisSettings& settings)
+{
+    if (!settings.windowed || numSamples <= settings.windowLength)
+        return 1;
+
+    auto hop = jmax (1, settings.hopLength);
+
+    ///Last window is zero padded so the end of the file is always covered
+    return 1 + (numSamples - settings.windowLength + hop - 1) / hop;
+}
+
+void WindowedClassifier::reset (const AnalysisSettings& newSettings)
+{
+    settings = newSettings;
+    settings.windowLength = jmax (1, settings.windowLength);
+    settings.hopLength = jmax (1, settings.hopLength);
+
+    result = {};
+    result.windowLogits.reserve ((size_t) numberOfEffects * 64);
+
+    batchSize = settings.windowed ? jmax (1, settings.maxBatchSize) : 1;
+    batchSpan = (batchSize - 1) * settings.hopLength + settings.windowLength;
+    signal.ensureSize ((size_t) batchSpan + writeSlack);
+
+    numInSignal = 0;
+    numToSkip = 0;
+    numWindowsDone = 0;
+}
+
+float* WindowedClassifier::getWritePointer (int numSamples)
+{
+    ///Only grows if a caller writes more than writeSlack samples at once
+    signal.ensureSize ((size_t) numInSignal + (size_t) jmax (0, numSamples));
+    return signal.data() + numInSignal;
+}
+
+void WindowedClassifier::commitSamples (SharedClassifier& model, int numSamples)
+{
+    auto* written = signal.data() + numInSignal;
+
+    ///Gap between two batches when the hop is longer than a window
+    if (numToSkip > 0)
+    {
+        auto skipped = jmin (numToSkip, numSamples);
+        numToSkip -= skipped;
+        numSamples -= skipped;
+        std::memmove (written, written + skipped, (size_t) numSamples * sizeof (float));
+    }
+
+    numInSignal += numSamples;
+
+    while (needsMoreSamples() && numInSignal >= batchSpan)
+    {
+        forwardWindows (model, batchSize);
+        advance (batchSize * settings.hopLength);
+    }
+}
+
+void WindowedClassifier::pushSamples (SharedClassifier& model, const float* samples, int numSamples)
+{
+    while (numSamples > 0 && needsMoreSamples())
+    {
+        auto numToCopy = jmin (numSamples, writeSlack);
+        FloatVectorOperations::copy (getWritePointer (numToCopy), samples, numToCopy);
+        commitSamples (model, numToCopy);
+
+        samples += numToCopy;
+        numSamples -= numToCopy;
+    }
+}
+
+void WindowedClassifier::advance (int numSamples)
+{
+    if (numSamples < numInSignal)
+    {
+        ///Keep the overlap with the next batch
+        numInSignal -= numSamples;
+        std::memmove (signal.data(), signal.data() + numSamples, (size_t) numInSignal * sizeof (float));
+    }
+    else
+    {
+        numToSkip = numSamples - numInSignal;
+        numInSignal = 0;
+    }
+}
+
+AnalysisResult WindowedClassifier::finish (SharedClassifier& model)
+{
+    const int windowLength = settings.windowLength;
+    const int hop = settings.hopLength;
+
+    if (needsMoreSamples())
+    {
+        ///Complete windows of the unfinished batch, they start every hop
+        auto numComplete = numInSignal >= windowLength ? jmin (batchSize, 1 + (numInSignal - windowLength) / hop) : 0;
+
+        if (!settings.windowed)
+            numComplete = jmin (1, numComplete);
+
+        ///Same windows as getNumWindows: one padded window for short signals, and one more if the end isn't covered yet
+        auto coveredEnd = numComplete > 0     ? (numComplete - 1) * hop + windowLength
+                        : numWindowsDone > 0  ? jmax (0, windowLength - hop)
+                                              : 0;
+        auto paddedStart = numComplete * hop;
+
+        bool needsPaddedWindow = numWindowsDone + numComplete == 0
+                                 || (settings.windowed && numInSignal > coveredEnd && paddedStart < numInSignal);
+
+        auto numWindows = numComplete;
+
+        if (needsPaddedWindow)
+        {
+            auto paddedEnd = paddedStart + windowLength;
+            signal.ensureSize ((size_t) paddedEnd);
+            FloatVectorOperations::clear (signal.data() + numInSignal, paddedEnd - numInSignal);
+            ++numWindows;
+        }
+
+        if (numWindows > 0)
+            forwardWindows (model, numWindows);
+    }
+
+    ScopedStageTimer timer (timings, AnalysisTimingRecord::PostProcess);
+    result.numWindows = numWindowsDone;
+
+    ///Average scores over windows and keep the best class
+    result.classScores.assign ((size_t) result.numClasses, 0.f);
+
+    for (int w = 0; w < result.numWindows; ++w)
+        FloatVectorOperations::add (result.classScores.data(),
+                                    result.windowLogits.data() + (size_t) w * (size_t) result.numClasses,
+                                    result.numClasses);
+
+    FloatVectorOperations::multiply (result.classScores.data(), 1.f / (float) jmax (1, result.numWindows), result.numClasses);
+
+    auto best = std::max_element (result.classScores.begin(), result.classScores.end());
+    auto bestIndex = (int) std::distance (result.classScores.begin(), best);
+    result.effect = static_cast<EffectEnum> (jlimit (0, numberOfEffects - 1, bestIndex));
+
+    return std::move (result);
+}
+
+AnalysisResult WindowedClassifier::classify (SharedClassifier& model, const float* samples, int numSamples,
+                                             const AnalysisSettings& newSettings)
+{
+    reset (newSettings);
+    pushSamples (model, samples, numSamples);
+    return finish (model);
+}
+
+void WindowedClassifier::forwardWindows (SharedClassifier& model, int numWindowsInBatch)
+{
+    numWindowsDone += numWindowsInBatch;
+
+    if (numWindowsInBatch > 1 && modelAcceptsBatches)
+    {
+        if (forwardBatch (model, signal.data(), numWindowsInBatch))
+            return;
+
+        DBG ("Classifier does not accept batched input, falling back to one window per call");
+        modelAcceptsBatches = false;
+    }
+
+    for (int w = 0; w < numWindowsInBatch; ++w)
+        if (!forwardBatch (model, signal.data() + (size_t) w * (size_t) settings.hopLength, 1))
+            throw std::runtime_error ("Unexpected classifier output shape");
+}
+
+bool WindowedClassifier::forwardBatch (SharedClassifier& model, float* firstWindow, int numWindowsInBatch)
+{
+    ClassifierInput input;
+
+    {
+        ScopedStageTimer timer (timings, AnalysisTimingRecord::TensorBuild);
+
+        if (model.takesLogMel())
+        {
+            input = buildLogMelInput (model, firstWindow, numWindowsInBatch);
+        }
+        else
+        {
+            ///Overlapping rows of the same memory, nothing is copied on our side
+            input.data = firstWindow;
+            input.numRows = numWindowsInBatch;
+            input.numFrames = settings.windowLength;
+            input.rowStride = numWindowsInBatch > 1 ? settings.hopLength : settings.windowLength;
+        }
+    }
+
+    try
+    {
+        ScopedStageTimer timer (timings, AnalysisTimingRecord::Forward);
+        model.forward (input, output);
+    }
+    catch (const std::exception&)
+    {
+        ///A single window is the historical input, a failure there is a real error
+        if (numWindowsInBatch == 1)
+            throw;
+        return false;
+    }
+
+    ScopedStageTimer timer (timings, AnalysisTimingRecord::PostProcess);
+    auto numValues = (int) output.size();
+
+    if (numValues == numWindowsInBatch)
+    {
+        ///Model already returns one class index per window, turn them into one-hot votes
+        if (result.numClasses == 0)
+            result.numClasses = numberOfEffects;
+
+        for (int w = 0; w < numWindowsInBatch; ++w)
+        {
+            auto rowStart = result.windowLogits.size();
+            result.windowLogits.resize (rowStart + (size_t) result.numClasses, 0.f);
+            result.windowLogits[rowStart + (size_t) jlimit (0, result.numClasses - 1, roundToInt (output[(size_t) w]))] = 1.f;
+        }
+        return true;
+    }
+
+    if (numValues == 0 || numValues % numWindowsInBatch != 0)
+        return false;
+
+    auto numClasses = numValues / numWindowsInBatch;
+
+    if (result.numClasses != 0 && result.numClasses != numClasses)
+        return false;
+    result.numClasses = numClasses;
+
+    result.windowLogits.insert (result.windowLogits.end(), output.begin(), output.end());
+    return true;
+}
+
+ClassifierInput WindowedClassifier::buildLogMelInput (SharedClassifier& model, const float* firstWindow, int numWindowsInBatch)
+{
+    if (logMel == nullptr || logMel->getSettings() != model.getLogMelSettings())
+        logMel.reset (new LogMelSpectrogram (model.getLogMelSettings()));
+
+    const int numMels = logMel->getNumMels();
+    const int frameHop = logMel->getSettings().hopLength;
+    const int framesPerWindow = logMel->getNumFrames (settings.windowLength);
+    const int64 windowSize = (int64) framesPerWindow * numMels;
+
+    ///The data pointer is set once the features buffer has its size
+    ClassifierInput input;
+    input.numRows = numWindowsInBatch;
+    input.numFrames = framesPerWindow;
+    input.numChannels = numMels;
+    input.isSpectrogram = true;
+
+    if (numWindowsInBatch == 1 || settings.hopLength % frameHop == 0)
+    {
+        ///Overlapping windows share their frames, every frame of the batch span is computed once
+        auto span = (numWindowsInBatch - 1) * settings.hopLength + settings.windowLength;
+        features.ensureSize ((size_t) jmax (1, logMel->getNumFrames (span)) * (size_t) numMels);
+        logMel->process (firstWindow, span, features.data());
+
+        input.data = features.data();
+        input.rowStride = numWindowsInBatch > 1 ? (int64) (settings.hopLength / frameHop) * numMels : windowSize;
+        return input;
+    }
+
+    ///Frames of two windows don't line up, each window gets its own
+    features.ensureSize ((size_t) jmax ((int64) 1, numWindowsInBatch * windowSize));
+
+    for (int w = 0; w < numWindowsInBatch; ++w)
+        logMel->process (firstWindow + (size_t) w * (size_t) settings.hopLength, settings.windowLength,
+                         features.data() + (size_t) w * (size_t) windowSize);
+
+    input.data = features.data();
+    input.rowStride = windowSize;
+    return input;
+}
@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    WindowedClassifier.h
+    Created: 17 Oct 2026 11:02:18am
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "AnalysisTypes.h"
+#include "SharedClassifier.h"
+#include "AlignedFloatBuffer.h"
+#include "AnalysisTimings.h"
+
+//==============================================================================
+/**
+    Runs the classifier over a signal at the model sample rate, fed block by block.
+
+    The signal is cut in overlapping windows of the model input size, windows are
+    grouped in batches of at most maxBatchSize rows and each batch goes through
+    one forward call as soon as it is complete. Per-window scores are then
+    averaged to pick the effect.
+
+    Samples are written once, in an aligned buffer holding the span of one batch,
+    and the model input is a strided view over it (row i starts i * hop samples
+    later), so overlapping windows are never copied. The buffer is kept between
+    analyses: once it has seen the biggest settings, an analysis doesn't allocate
+    for the signal anymore.
+
+    Models taking log-mel frames get the same treatment: when the window hop is a
+    multiple of the frame hop, the frames of the whole batch span are computed once
+    and each window is a strided view starting hop / frameHop frames later.
+
+    @code
+    classifier.reset (settings);
+    while (classifier.needsMoreSamples() && source.readNextBlock (classifier.getWritePointer (maxBlockSize), numSamples))
+        classifier.commitSamples (model, numSamples);
+    auto result = classifier.finish (model);
+    @endcode
+*/
+class WindowedClassifier
+{
+public:
+    WindowedClassifier() = default;
+
+    void reset (const AnalysisSettings& newSettings);
+
+    /** Where the next numSamples samples must be written, then call commitSamples(). */
+    float* getWritePointer (int numSamples);
+
+    /** Takes the samples written at getWritePointer() and runs every batch they complete. */
+    void commitSamples (SharedClassifier& model, int numSamples);
+
+    ///Copying version of getWritePointer() + commitSamples()
+    void pushSamples (SharedClassifier& model, const float* samples, int numSamples);
+
+    ///False once the first window is full when the windowed mode is off, or once cancelled
+    bool needsMoreSamples() const { return (settings.windowed || numWindowsDone == 0) && !isCancelled(); }
+
+    ///Zero pads the last window, runs the last batch and aggregates the scores
+    AnalysisResult finish (SharedClassifier& model);
+
+    ///Convenience for a signal already in memory
+    AnalysisResult classify (SharedClassifier& model, const float* samples, int numSamples,
+                             const AnalysisSettings& newSettings);
+
+    static int getNumWindows (int numSamples, const AnalysisSettings& settings);
+
+    ///Tensor build, forward and post-process time are added to this record, nullptr to stop timing
+    void setTimings (AnalysisTimingRecord* record) noexcept { timings = record; }
+
+    /** Once cancelled, commitSamples() stops running batches and needsMoreSamples() returns false.
+        The result of finish() is then meaningless. nullptr for an analysis that can't be cancelled.
+    */
+    void setCancellation (const AnalysisCancellation* newCancellation) noexcept { cancellation = newCancellation; }
+
+    bool isCancelled() const noexcept { return cancellation != nullptr && cancellation->isCancelled(); }
+
+private:
+    ///Classifies the first numWindowsInBatch windows of the signal buffer
+    void forwardWindows (SharedClassifier& model, int numWindowsInBatch);
+
+    ///Returns false if the model output can't be read as one row per window
+    bool forwardBatch (SharedClassifier& model, float* firstWindow, int numWindowsInBatch);
+
+    ///[windows, frames, mels] input of a spectrogram model, computed in the features buffer
+    ClassifierInput buildLogMelInput (SharedClassifier& model, const float* firstWindow, int numWindowsInBatch);
+
+    ///Drops the first numSamples samples of the signal buffer once their windows are done
+    void advance (int numSamples);
+
+    AnalysisSettings settings;
+    AnalysisResult result;
+
+    ///Signal of the current batch, window i starts at i * hopLength
+    AlignedFloatBuffer signal;
+    int numInSignal = 0;
+    int numToSkip = 0;
+
+    int batchSize = 1;
+    int batchSpan = 0;
+    int numWindowsDone = 0;
+
+    ///Cleared the first time the model refuses a batch of more than one window
+    bool modelAcceptsBatches = true;
+
+    ///Only created for spectrogram-input models, rebuilt if the model settings change
+    std::unique_ptr<LogMelSpectrogram> logMel;
+    AlignedFloatBuffer features;
+
+    ///Values returned by the last forward call, kept so that batches don't allocate
+    std::vector<float> output;
+
+    AnalysisTimingRecord* timings = nullptr;
+    const AnalysisCancellation* cancellation = nullptr;
+
+    ///Room kept after a full batch so a reader block can always be written in place
+    static constexpr int writeSlack = 32768;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WindowedClassifier)
+};
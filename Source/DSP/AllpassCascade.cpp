@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    AllpassCascade.cpp
+    Created: 22 Oct 2026 10:58:02am
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#include "AllpassCascade.h"
+
+void AllpassCascade::prepare (double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    reset();
+}
+
+void AllpassCascade::reset()
+{
+    std::fill (std::begin (states), std::end (states), 0.f);
+    lastOutput = 0.f;
+}
+
+void AllpassCascade::setRange (float lowestHz, float highestHz)
+{
+    lowest = jmax (20.f, lowestHz);
+    highest = jmax (lowest, highestHz);
+}
+
+void AllpassCascade::process (float* samples, const float* modulation, int numSamples, float feedback, float mix) noexcept
+{
+    ///Above about a fifth of the rate the small angle approximation drifts too far from tan
+    const auto radiansPerHz = MathConstants<float>::pi / (float) sampleRate;
+    const auto lowestAngle = jmin (lowest * radiansPerHz, 0.6f);
+    const auto angleRange = jmin (highest * radiansPerHz, 0.6f) - lowestAngle;
+
+    const auto wet = mix;
+    const auto dry = 1.f - mix;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        auto position = 0.5f + 0.5f * modulation[i];
+        auto angle = lowestAngle + angleRange * position * position;
+        auto coefficient = (angle - 1.f) / (angle + 1.f);
+
+        auto input = samples[i];
+        auto x = input + feedback * lastOutput;
+
+        ///(c + z^-1) / (1 + c z^-1), transposed direct form II
+        for (auto& state : states)
+        {
+            auto y = coefficient * x + state;
+            state = x - coefficient * y;
+            x = y;
+        }
+
+        lastOutput = x;
+        samples[i] = dry * input + wet * x;
+    }
+}
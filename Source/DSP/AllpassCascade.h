@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    AllpassCascade.h
+    Created: 22 Oct 2026 10:58:02am
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../Analysis/VectorKernels.h"
+
+//==============================================================================
+/**
+    One channel of a phaser: first order allpass stages in series whose corner
+    frequency follows an LFO, mixed with the dry signal so their phase shift turns
+    into moving notches.
+
+    The corner sweeps from the lowest to the highest frequency on a squared curve,
+    which spends more time low like an exponential sweep, and the coefficient uses
+    the small angle tan (x) ~ x: one division per sample instead of an exp and a tan.
+*/
+class AllpassCascade
+{
+public:
+    static constexpr int numStages = 6;
+
+    AllpassCascade() = default;
+
+    void prepare (double sampleRate);
+    void reset();
+
+    ///Corner frequencies at the bottom and the top of the LFO
+    void setRange (float lowestHz, float highestHz);
+
+    ///In place, modulation in [-1, 1]
+    void process (float* samples, const float* modulation, int numSamples, float feedback, float mix) noexcept;
+
+private:
+    double sampleRate = 44100.0;
+    float lowest = 200.f;
+    float highest = 2000.f;
+
+    float states[numStages] = {};
+    float lastOutput = 0.f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AllpassCascade)
+};
@@ -0,0 +1,155 @@
+/*
+  ==============================================================================
+
+    FeedbackDelayNetwork.cpp
+    Created: 21 Oct 2026 10:17:52am
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#include "FeedbackDelayNetwork.h"
+#include "SimdLanes.h"
+
+namespace
+{
+    ///Lengths of a size 1 room in milliseconds, spread so that their echoes rarely line up
+    constexpr float baseLengthsMs[FeedbackDelayNetwork::numLines] = { 29.7f, 33.9f, 37.1f, 41.3f, 45.7f, 51.1f, 56.3f, 63.7f };
+
+    ///High frequency cut-off of the per-line damping at damping 0 and 1
+    constexpr float brightestCutoff = 18000.f;
+    constexpr float darkestCutoff = 1200.f;
+}
+
+void FeedbackDelayNetwork::prepare (double newSampleRate)
+{
+    sampleRate = newSampleRate;
+
+    auto longest = (double) *std::max_element (std::begin (baseLengthsMs), std::end (baseLengthsMs));
+    capacity = nextPowerOfTwo ((int) std::ceil (longest * maximumSize * 0.001 * sampleRate) + 2);
+    mask = capacity - 1;
+
+    frames.allocate ((size_t) (numLines * capacity), true);
+
+    updateLines();
+    setDamping (damping);
+    reset();
+}
+
+void FeedbackDelayNetwork::reset()
+{
+    if (frames != nullptr)
+        FloatVectorOperations::clear (frames.get(), numLines * capacity);
+
+    writeIndex = 0;
+    std::fill (std::begin (toneStates), std::end (toneStates), 0.f);
+}
+
+void FeedbackDelayNetwork::setDecayTime (float seconds)
+{
+    decayTime = jlimit (0.1f, 30.f, seconds);
+    updateLines();
+}
+
+void FeedbackDelayNetwork::setSize (float newSize)
+{
+    size = jlimit (minimumSize, maximumSize, newSize);
+    updateLines();
+}
+
+void FeedbackDelayNetwork::setDamping (float newDamping)
+{
+    damping = jlimit (0.f, 1.f, newDamping);
+
+    auto cutoff = brightestCutoff * std::pow (darkestCutoff / brightestCutoff, damping);
+    toneCoefficient = 1.f - std::exp (-MathConstants<float>::twoPi * jmin (cutoff, 0.45f * (float) sampleRate) / (float) sampleRate);
+}
+
+void FeedbackDelayNetwork::updateLines()
+{
+    const auto matrixScale = 1.f / std::sqrt ((float) numLines);
+
+    for (int line = 0; line < numLines; ++line)
+    {
+        lineLengths[line] = jlimit (1, jmax (1, capacity - 2), roundToInt (baseLengthsMs[line] * size * 0.001 * sampleRate));
+
+        ///A trip through this line must lose lineLength / (decayTime * sampleRate) of the 60 dB
+        auto decibelsPerTrip = -60.0 * lineLengths[line] / (decayTime * sampleRate);
+        lineGains[line] = matrixScale * (float) std::pow (10.0, decibelsPerTrip / 20.0);
+    }
+}
+
+double FeedbackDelayNetwork::getTailLengthSeconds() const noexcept
+{
+    return decayTime + *std::max_element (std::begin (lineLengths), std::end (lineLengths)) / sampleRate;
+}
+
+void FeedbackDelayNetwork::process (float* left, float* right, int numSamples) noexcept
+{
+    jassert (frames != nullptr);
+
+    auto* buffer = frames.get();
+
+    ///Both outputs take every line, with sign patterns orthogonal to each other so they don't sound alike
+    const auto outputScale = 0.5f;
+    const auto leftSignsA  = SimdLanes::set (1.f, -1.f,  1.f, -1.f) * SimdLanes::broadcast (outputScale);
+    const auto leftSignsB  = SimdLanes::set (1.f,  1.f, -1.f, -1.f) * SimdLanes::broadcast (outputScale);
+    const auto rightSignsA = SimdLanes::set (1.f,  1.f, -1.f, -1.f) * SimdLanes::broadcast (outputScale);
+    const auto rightSignsB = SimdLanes::set (-1.f, 1.f,  1.f, -1.f) * SimdLanes::broadcast (outputScale);
+
+    ///Left feeds the first four lines, right the last four
+    const auto inputSigns = SimdLanes::set (1.f, -1.f, 1.f, -1.f);
+    const auto neighbourSigns = SimdLanes::set (1.f, -1.f, 1.f, -1.f);
+    const auto halfSigns = SimdLanes::set (1.f, 1.f, -1.f, -1.f);
+
+    const auto gainsA = SimdLanes::load (lineGains);
+    const auto gainsB = SimdLanes::load (lineGains + 4);
+    const auto tone = SimdLanes::broadcast (toneCoefficient);
+    auto toneA = SimdLanes::load (toneStates);
+    auto toneB = SimdLanes::load (toneStates + 4);
+
+    const auto wet = mix;
+    const auto dry = 1.f - mix;
+
+    for (int n = 0; n < numSamples; ++n)
+    {
+        ///One tap per line, each at its own length behind the shared write index
+        const auto* f = buffer;
+        const auto w = writeIndex;
+        auto delayedA = SimdLanes::set (f[((w - lineLengths[0]) & mask) * numLines + 0], f[((w - lineLengths[1]) & mask) * numLines + 1],
+                                    f[((w - lineLengths[2]) & mask) * numLines + 2], f[((w - lineLengths[3]) & mask) * numLines + 3]);
+        auto delayedB = SimdLanes::set (f[((w - lineLengths[4]) & mask) * numLines + 4], f[((w - lineLengths[5]) & mask) * numLines + 5],
+                                    f[((w - lineLengths[6]) & mask) * numLines + 6], f[((w - lineLengths[7]) & mask) * numLines + 7]);
+
+        toneA = toneA + tone * (delayedA - toneA);
+        toneB = toneB + tone * (delayedB - toneB);
+
+        auto wetLeft = (toneA * leftSignsA + toneB * leftSignsB).sum();
+        auto wetRight = (toneA * rightSignsA + toneB * rightSignsB).sum();
+
+        // Fast Walsh-Hadamard transform of the 8 decayed lines: across the registers, then inside each
+        auto a = toneA * gainsA;
+        auto b = toneB * gainsB;
+        auto sum = a + b;
+        auto difference = a - b;
+
+        a = sum * neighbourSigns + sum.swapNeighbours();
+        b = difference * neighbourSigns + difference.swapNeighbours();
+        a = a * halfSigns + a.swapHalves();
+        b = b * halfSigns + b.swapHalves();
+
+        auto inputLeft = left[n];
+        auto inputRight = right[n];
+
+        (a + SimdLanes::broadcast (inputLeft) * inputSigns).store (buffer + w * numLines);
+        (b + SimdLanes::broadcast (inputRight) * inputSigns).store (buffer + w * numLines + 4);
+
+        left[n] = dry * inputLeft + wet * wetLeft;
+        right[n] = dry * inputRight + wet * wetRight;
+
+        writeIndex = (w + 1) & mask;
+    }
+
+    toneA.store (toneStates);
+    toneB.store (toneStates + 4);
+}
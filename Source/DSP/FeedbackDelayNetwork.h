@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    FeedbackDelayNetwork.h
+    Created: 21 Oct 2026 10:17:52am
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../Analysis/VectorKernels.h"
+
+//==============================================================================
+/**
+    Stereo reverb made of 8 delay lines fed back into each other through a Hadamard
+    matrix, the engine of the reverb effect.
+
+    The 8 lines are two groups of 4 SIMD lanes: one frame of the network is one
+    8 float write, a per-line damping filter and gain, and a fast Walsh-Hadamard
+    transform of 3 butterfly stages done with add, multiply and lane swaps. The
+    matrix is orthogonal, so the decay only depends on the per-line gains, which are
+    set from the wanted decay time and the length of each line.
+
+    Lines share one interleaved buffer with a single power of two capacity and write
+    index. It is sized in prepare() for the largest room, later changes of any
+    setting never reallocate.
+*/
+class FeedbackDelayNetwork
+{
+public:
+    static constexpr int numLines = 8;
+
+    FeedbackDelayNetwork() = default;
+
+    ///Allocates, not on the audio thread. Clears the network
+    void prepare (double sampleRate);
+    void reset();
+
+    ///Time for the tail to fall by 60 dB, in seconds
+    void setDecayTime (float seconds);
+
+    ///Line lengths scale, 1 is a mid-sized room. Clamped to [minimumSize, maximumSize]
+    void setSize (float newSize);
+
+    ///0 keeps the highs as long as the lows, 1 makes them die out much faster
+    void setDamping (float newDamping);
+
+    void setMix (float newMix)      { mix = jlimit (0.f, 1.f, newMix); }
+
+    /** In place. right may be the same pointer as left for a mono buffer. */
+    void process (float* left, float* right, int numSamples) noexcept;
+
+    ///Decay time plus the longest line, after which an impulse has faded below -60 dB
+    double getTailLengthSeconds() const noexcept;
+
+    static constexpr float minimumSize = 0.25f;
+    static constexpr float maximumSize = 2.f;
+
+private:
+    void updateLines();
+
+    HeapBlock<float> frames;   ///capacity frames of numLines floats
+    int capacity = 0;
+    int mask = 0;
+    int writeIndex = 0;
+
+    double sampleRate = 44100.0;
+    float decayTime = 2.f;
+    float size = 1.f;
+    float damping = 0.4f;
+    float mix = 0.3f;
+
+    int lineLengths[numLines] = {};
+
+    alignas (16) float lineGains[numLines] = {};    ///Per-line decay, times the 1 / sqrt (8) of the matrix
+    alignas (16) float toneStates[numLines] = {};
+    float toneCoefficient = 1.f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FeedbackDelayNetwork)
+};
@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    ModulatedDelayLine.cpp
+    Created: 22 Oct 2026 10:31:45am
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#include "ModulatedDelayLine.h"
+
+void ModulatedDelayLine::prepare (double sampleRate, double maximumDelaySeconds)
+{
+    ///Two spare samples: the interpolated read needs one sample older than the delay
+    capacity = nextPowerOfTwo ((int) std::ceil (maximumDelaySeconds * sampleRate) + 2);
+    mask = capacity - 1;
+
+    buffer.allocate ((size_t) capacity, true);
+    reset();
+}
+
+void ModulatedDelayLine::reset()
+{
+    if (buffer != nullptr)
+        FloatVectorOperations::clear (buffer.get(), capacity);
+
+    writeIndex = 0;
+}
+
+void ModulatedDelayLine::process (float* samples, const float* modulation, int numSamples,
+                                  float centreSamples, float depthSamples, float feedback, float mix) noexcept
+{
+    jassert (buffer != nullptr);
+
+    ///Clamped once for the block, the modulation is in [-1, 1]
+    auto centre = jlimit (1.f, getMaximumDelaySamples(), centreSamples);
+    auto depth = jlimit (0.f, jmin (centre - 1.f, getMaximumDelaySamples() - centre), depthSamples);
+
+    const auto wet = mix;
+    const auto dry = 1.f - mix;
+    auto* delayBuffer = buffer.get();
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        auto delay = centre + depth * modulation[i];
+        auto whole = (int) delay;
+        auto fraction = delay - (float) whole;
+
+        auto newer = delayBuffer[(writeIndex - whole) & mask];
+        auto older = delayBuffer[(writeIndex - whole - 1) & mask];
+        auto delayed = newer + fraction * (older - newer);
+
+        auto input = samples[i];
+        delayBuffer[writeIndex] = input + feedback * delayed;
+        samples[i] = dry * input + wet * delayed;
+
+        writeIndex = (writeIndex + 1) & mask;
+    }
+}
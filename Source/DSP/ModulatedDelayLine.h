@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    ModulatedDelayLine.h
+    Created: 22 Oct 2026 10:31:45am
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../Analysis/VectorKernels.h"
+
+//==============================================================================
+/**
+    One channel of a short delay whose time follows an LFO sample by sample, the
+    engine of the flanger and the vibrato.
+
+    The delay is read with linear interpolation from a power of two buffer, sized
+    once in prepare() for the longest delay.
+*/
+class ModulatedDelayLine
+{
+public:
+    ModulatedDelayLine() = default;
+
+    ///Allocates, not on the audio thread. Clears the buffer
+    void prepare (double sampleRate, double maximumDelaySeconds);
+    void reset();
+
+    /** In place. Sample i is delayed by centre + depth * modulation[i] samples, depth is
+        reduced if needed so that the delay stays between 1 sample and the maximum.
+    */
+    void process (float* samples, const float* modulation, int numSamples,
+                  float centreSamples, float depthSamples, float feedback, float mix) noexcept;
+
+    float getMaximumDelaySamples() const noexcept   { return (float) (capacity - 2); }
+
+private:
+    HeapBlock<float> buffer;
+    int capacity = 0;
+    int mask = 0;
+    int writeIndex = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ModulatedDelayLine)
+};
@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+    ModulationCore.cpp
+    Created: 22 Oct 2026 9:54:20am
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#include "ModulationCore.h"
+#include "SimdLanes.h"
+
+namespace
+{
+    ///Odd polynomial fitted to sin (pi / 2 * x) on [-1, 1], within 2e-6
+    constexpr float sine1 = 1.5707924f;
+    constexpr float sine3 = -0.6459059f;
+    constexpr float sine5 = 0.0794646f;
+    constexpr float sine7 = -0.0043527f;
+
+    ///cos (2 pi phase) = -sin (pi / 2 * (4 |phase| - 1)) for a phase in [-0.5, 0.5]
+    SimdLanes cosineLanes (SimdLanes phase) noexcept
+    {
+        auto x = phase.abs() * SimdLanes::broadcast (4.f) - SimdLanes::broadcast (1.f);
+        auto x2 = x * x;
+        auto polynomial = SimdLanes::broadcast (sine5) + x2 * SimdLanes::broadcast (sine7);
+        polynomial = SimdLanes::broadcast (sine3) + x2 * polynomial;
+        polynomial = SimdLanes::broadcast (sine1) + x2 * polynomial;
+        return SimdLanes::broadcast (0.f) - x * polynomial;
+    }
+
+    ///Back to [-0.5, 0.5] for phases from -0.5 up, rates are never negative
+    SimdLanes wrapPhase (SimdLanes phase) noexcept
+    {
+        return phase - (phase + SimdLanes::broadcast (0.5f)).truncate();
+    }
+}
+
+float ModulationCore::cosine (float phase) noexcept
+{
+    phase -= std::floor (phase + 0.5f);
+
+    auto x = 4.f * std::abs (phase) - 1.f;
+    auto x2 = x * x;
+    return -x * (sine1 + x2 * (sine3 + x2 * (sine5 + x2 * sine7)));
+}
+
+void ModulationCore::prepare (double newSampleRate, int newMaximumBlockSize, int maximumLfos)
+{
+    sampleRate = newSampleRate;
+    maximumBlockSize = jmax (1, newMaximumBlockSize);
+    capacity = jmax (1, maximumLfos);
+    numLanes = (capacity + 3) & ~3;
+    numLfos = 0;
+
+    auto maximumPoints = (maximumBlockSize + controlInterval - 1) / controlInterval + 1;
+
+    values.allocate ((size_t) (numLanes * maximumBlockSize), true);
+    controlPoints.allocate ((size_t) (numLanes * maximumPoints), true);
+    phases.allocate ((size_t) numLanes, true);
+    increments.allocate ((size_t) numLanes, true);
+    initialPhases.allocate ((size_t) numLanes, true);
+}
+
+int ModulationCore::addLfo (float rateHz, float phase)
+{
+    if (numLfos >= capacity)
+    {
+        jassertfalse;
+        return -1;
+    }
+
+    auto lfo = numLfos++;
+    initialPhases[lfo] = phase - std::floor (phase + 0.5f);
+    setRate (lfo, rateHz);
+    resetPhase (lfo);
+    return lfo;
+}
+
+void ModulationCore::setRate (int lfo, float rateHz)
+{
+    jassert (isPositiveAndBelow (lfo, numLfos));
+    increments[lfo] = jmax (0.f, rateHz) / (float) sampleRate;
+}
+
+void ModulationCore::resetPhase (int lfo)
+{
+    jassert (isPositiveAndBelow (lfo, numLfos));
+    phases[lfo] = initialPhases[lfo];
+    setLastValue (lfo);
+}
+
+void ModulationCore::setLastValue (int lfo)
+{
+    controlPoints[lfo] = cosine (phases[lfo]);
+}
+
+void ModulationCore::advance (int numSamples) noexcept
+{
+    if (numLfos == 0 || numSamples <= 0)
+        return;
+
+    jassert (numSamples <= maximumBlockSize);
+
+    const auto numPoints = (numSamples + controlInterval - 1) / controlInterval;
+    auto* points = controlPoints.get();
+
+    ///Each point from the block start phase, so rounding errors don't add up along the block
+    for (int lane = 0; lane < numLfos; lane += 4)
+    {
+        auto start = SimdLanes::load (phases + lane);
+        auto increment = SimdLanes::load (increments + lane);
+
+        for (int point = 1; point <= numPoints; ++point)
+        {
+            auto offset = SimdLanes::broadcast ((float) jmin (point * controlInterval, numSamples));
+            cosineLanes (wrapPhase (start + increment * offset)).store (points + point * numLanes + lane);
+        }
+
+        wrapPhase (start + increment * SimdLanes::broadcast ((float) numSamples)).store (phases + lane);
+    }
+
+    ///Straight lines between the points, each segment ends on its point
+    const auto ramp = SimdLanes::set (1.f, 2.f, 3.f, 4.f);
+
+    for (int lfo = 0; lfo < numLfos; ++lfo)
+    {
+        auto* output = values + lfo * maximumBlockSize;
+        auto previous = points[lfo];
+
+        for (int point = 1; point <= numPoints; ++point)
+        {
+            auto begin = (point - 1) * controlInterval;
+            auto end = jmin (point * controlInterval, numSamples);
+            auto next = points[point * numLanes + lfo];
+            auto slope = (next - previous) / (float) (end - begin);
+
+            auto line = SimdLanes::broadcast (previous) + ramp * SimdLanes::broadcast (slope);
+            const auto step = SimdLanes::broadcast (4.f * slope);
+            int i = begin;
+
+            for (; i + 4 <= end; i += 4)
+            {
+                line.store (output + i);
+                line = line + step;
+            }
+
+            for (; i < end; ++i)
+                output[i] = previous + slope * (float) (i + 1 - begin);
+
+            previous = next;
+        }
+
+        points[lfo] = previous;
+    }
+}
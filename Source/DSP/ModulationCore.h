@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    ModulationCore.h
+    Created: 22 Oct 2026 9:54:20am
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../Analysis/VectorKernels.h"
+
+//==============================================================================
+/**
+    Block-rate LFOs shared by the modulation effects.
+
+    Every block, advance() evaluates each LFO once every controlInterval samples,
+    four LFOs per SIMD operation with a polynomial cosine, then fills a per-sample
+    buffer by linear interpolation between those points. An effect reads its LFOs
+    with getValues() and never calls sin or cos itself.
+
+    One core can serve every modulation effect of a chain: each effect adds its LFOs
+    to it, and the owner advances it once per block before the effects run.
+*/
+class ModulationCore
+{
+public:
+    ///Samples between two evaluated points, about 0.7 ms at 44.1 kHz
+    static constexpr int controlInterval = 32;
+
+    ModulationCore() = default;
+
+    ///Allocates, not on the audio thread. Removes every LFO
+    void prepare (double sampleRate, int maximumBlockSize, int maximumLfos);
+
+    /** Not on the audio thread once the core is used there. Phase 0 starts at the top
+        of the cosine, 0.5 at the bottom. Returns the index of the LFO, -1 if full.
+    */
+    int addLfo (float rateHz, float phase);
+
+    ///Applied from the next block. Negative rates are treated as 0
+    void setRate (int lfo, float rateHz);
+
+    ///Back to the phase the LFO was added with
+    void resetPhase (int lfo);
+
+    ///Computes numSamples values of every LFO, which replace the previous block ones
+    void advance (int numSamples) noexcept;
+
+    ///In [-1, 1], as many as the last advance() asked for
+    const float* getValues (int lfo) const noexcept   { return values.get() + lfo * maximumBlockSize; }
+
+    int getNumLfos() const noexcept                    { return numLfos; }
+
+    ///The cosine advance() evaluates, for a phase in cycles
+    static float cosine (float phase) noexcept;
+
+private:
+    void setLastValue (int lfo);
+
+    HeapBlock<float> values;            ///maximumBlockSize per LFO
+    HeapBlock<float> controlPoints;     ///numLanes per point, the first row holds the last value of the previous block
+
+    ///numLanes each, capacity rounded up to a multiple of 4. Phases are kept in [-0.5, 0.5]
+    HeapBlock<float> phases;
+    HeapBlock<float> increments;
+    HeapBlock<float> initialPhases;
+
+    double sampleRate = 44100.0;
+    int maximumBlockSize = 0;
+    int capacity = 0;
+    int numLanes = 0;
+    int numLfos = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ModulationCore)
+};
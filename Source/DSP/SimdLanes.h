@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+    SimdLanes.h
+    Created: 21 Oct 2026 2:36:08pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../Analysis/VectorKernels.h"
+
+//==============================================================================
+/**
+    Four floats in one SSE or NEON register, with a plain array fallback, so the
+    effect kernels are written once for every target.
+
+    Only holds what the kernels use: arithmetic, min, max, abs and truncation, and
+    the two lane moves of butterfly stages. Loads and stores don't need aligned
+    pointers.
+*/
+struct SimdLanes
+{
+   #if AUTOEFFECT_USE_SSE
+    __m128 v;
+
+    static SimdLanes set (float a, float b, float c, float d) noexcept  { return { _mm_setr_ps (a, b, c, d) }; }
+    static SimdLanes broadcast (float x) noexcept                       { return { _mm_set1_ps (x) }; }
+    static SimdLanes load (const float* p) noexcept                     { return { _mm_loadu_ps (p) }; }
+    void store (float* p) const noexcept                                { _mm_storeu_ps (p, v); }
+
+    SimdLanes operator+ (SimdLanes o) const noexcept   { return { _mm_add_ps (v, o.v) }; }
+    SimdLanes operator- (SimdLanes o) const noexcept   { return { _mm_sub_ps (v, o.v) }; }
+    SimdLanes operator* (SimdLanes o) const noexcept   { return { _mm_mul_ps (v, o.v) }; }
+
+    static SimdLanes min (SimdLanes a, SimdLanes b) noexcept   { return { _mm_min_ps (a.v, b.v) }; }
+    static SimdLanes max (SimdLanes a, SimdLanes b) noexcept   { return { _mm_max_ps (a.v, b.v) }; }
+
+    SimdLanes abs() const noexcept                     { return { _mm_andnot_ps (_mm_set1_ps (-0.f), v) }; }
+    ///Towards zero, in the range of an int
+    SimdLanes truncate() const noexcept                { return { _mm_cvtepi32_ps (_mm_cvttps_epi32 (v)) }; }
+
+    ///a1 a0 a3 a2
+    SimdLanes swapNeighbours() const noexcept          { return { _mm_shuffle_ps (v, v, _MM_SHUFFLE (2, 3, 0, 1)) }; }
+    ///a2 a3 a0 a1
+    SimdLanes swapHalves() const noexcept              { return { _mm_shuffle_ps (v, v, _MM_SHUFFLE (1, 0, 3, 2)) }; }
+
+    float sum() const noexcept
+    {
+        auto pairs = _mm_add_ps (v, _mm_movehl_ps (v, v));
+        return _mm_cvtss_f32 (_mm_add_ss (pairs, _mm_shuffle_ps (pairs, pairs, _MM_SHUFFLE (1, 1, 1, 1))));
+    }
+   #elif AUTOEFFECT_USE_NEON
+    float32x4_t v;
+
+    static SimdLanes set (float a, float b, float c, float d) noexcept
+    {
+        alignas (16) const float values[] = { a, b, c, d };
+        return { vld1q_f32 (values) };
+    }
+
+    static SimdLanes broadcast (float x) noexcept                       { return { vdupq_n_f32 (x) }; }
+    static SimdLanes load (const float* p) noexcept                     { return { vld1q_f32 (p) }; }
+    void store (float* p) const noexcept                                { vst1q_f32 (p, v); }
+
+    SimdLanes operator+ (SimdLanes o) const noexcept   { return { vaddq_f32 (v, o.v) }; }
+    SimdLanes operator- (SimdLanes o) const noexcept   { return { vsubq_f32 (v, o.v) }; }
+    SimdLanes operator* (SimdLanes o) const noexcept   { return { vmulq_f32 (v, o.v) }; }
+
+    static SimdLanes min (SimdLanes a, SimdLanes b) noexcept   { return { vminq_f32 (a.v, b.v) }; }
+    static SimdLanes max (SimdLanes a, SimdLanes b) noexcept   { return { vmaxq_f32 (a.v, b.v) }; }
+
+    SimdLanes abs() const noexcept                     { return { vabsq_f32 (v) }; }
+    SimdLanes truncate() const noexcept                { return { vcvtq_f32_s32 (vcvtq_s32_f32 (v)) }; }
+
+    SimdLanes swapNeighbours() const noexcept          { return { vrev64q_f32 (v) }; }
+    SimdLanes swapHalves() const noexcept              { return { vextq_f32 (v, v, 2) }; }
+
+    float sum() const noexcept
+    {
+        auto pairs = vadd_f32 (vget_low_f32 (v), vget_high_f32 (v));
+        return vget_lane_f32 (vpadd_f32 (pairs, pairs), 0);
+    }
+   #else
+    float v[4];
+
+    static SimdLanes set (float a, float b, float c, float d) noexcept  { return { { a, b, c, d } }; }
+    static SimdLanes broadcast (float x) noexcept                       { return { { x, x, x, x } }; }
+    static SimdLanes load (const float* p) noexcept                     { return { { p[0], p[1], p[2], p[3] } }; }
+    void store (float* p) const noexcept                                { std::copy (v, v + 4, p); }
+
+    SimdLanes operator+ (SimdLanes o) const noexcept   { return { { v[0] + o.v[0], v[1] + o.v[1], v[2] + o.v[2], v[3] + o.v[3] } }; }
+    SimdLanes operator- (SimdLanes o) const noexcept   { return { { v[0] - o.v[0], v[1] - o.v[1], v[2] - o.v[2], v[3] - o.v[3] } }; }
+    SimdLanes operator* (SimdLanes o) const noexcept   { return { { v[0] * o.v[0], v[1] * o.v[1], v[2] * o.v[2], v[3] * o.v[3] } }; }
+
+    static SimdLanes min (SimdLanes a, SimdLanes b) noexcept
+    {
+        return { { jmin (a.v[0], b.v[0]), jmin (a.v[1], b.v[1]), jmin (a.v[2], b.v[2]), jmin (a.v[3], b.v[3]) } };
+    }
+
+    static SimdLanes max (SimdLanes a, SimdLanes b) noexcept
+    {
+        return { { jmax (a.v[0], b.v[0]), jmax (a.v[1], b.v[1]), jmax (a.v[2], b.v[2]), jmax (a.v[3], b.v[3]) } };
+    }
+
+    SimdLanes abs() const noexcept                     { return { { std::abs (v[0]), std::abs (v[1]), std::abs (v[2]), std::abs (v[3]) } }; }
+
+    SimdLanes truncate() const noexcept
+    {
+        return { { (float) (int) v[0], (float) (int) v[1], (float) (int) v[2], (float) (int) v[3] } };
+    }
+
+    SimdLanes swapNeighbours() const noexcept          { return { { v[1], v[0], v[3], v[2] } }; }
+    SimdLanes swapHalves() const noexcept              { return { { v[2], v[3], v[0], v[1] } }; }
+
+    float sum() const noexcept                         { return (v[0] + v[1]) + (v[2] + v[3]); }
+   #endif
+};
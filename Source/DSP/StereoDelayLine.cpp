@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+    StereoDelayLine.cpp
+    Created: 20 Oct 2026 8:41:15pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#include "StereoDelayLine.h"
+
+void StereoDelayLine::prepare (double newSampleRate, double maximumDelaySeconds)
+{
+    sampleRate = newSampleRate;
+
+    ///Two spare frames: the interpolated read needs one frame older than the delay
+    capacity = nextPowerOfTwo ((int) std::ceil (maximumDelaySeconds * sampleRate) + 2);
+    mask = capacity - 1;
+    maximumDelaySamples = (float) (capacity - 2);
+
+    frames.allocate ((size_t) (4 * capacity), true);
+
+    delaySamples.reset (sampleRate, delaySmoothingSeconds);
+    setDelaySeconds (delaySeconds);
+    delaySamples.setCurrentAndTargetValue (delaySamples.getTargetValue());
+
+    reset();
+}
+
+void StereoDelayLine::reset()
+{
+    if (frames != nullptr)
+        FloatVectorOperations::clear (frames.get(), 4 * capacity);
+
+    writeIndex = 0;
+    toneState[0] = toneState[1] = 0.f;
+}
+
+void StereoDelayLine::setDelaySeconds (float seconds)
+{
+    delaySeconds = seconds;
+    delaySamples.setTargetValue (jlimit (1.f, maximumDelaySamples, seconds * (float) sampleRate));
+}
+
+void StereoDelayLine::process (float* left, float* right, int numSamples) noexcept
+{
+    jassert (frames != nullptr);
+
+    auto* buffer = frames.get();
+    const auto wet = mix;
+    const auto dry = 1.f - mix;
+    int n = 0;
+
+    // Reads the frame 'whole + 1' samples old and the one after it, so that a delay of 'whole + fraction'
+    // is newer + fraction * (older - newer). Both sit next to each other even across the wrap thanks to the mirror.
+
+   #if AUTOEFFECT_USE_SSE
+    const auto feedbackV = _mm_set1_ps (feedback);
+    const auto dampingV = _mm_set1_ps (damping);
+    const auto dryV = _mm_set1_ps (dry);
+    const auto wetV = _mm_set1_ps (wet);
+    auto tone = _mm_setr_ps (toneState[0], toneState[1], 0.f, 0.f);
+
+    for (; n < numSamples; ++n)
+    {
+        auto delay = delaySamples.getNextValue();
+        auto whole = (int) delay;
+        auto readIndex = (writeIndex - whole - 1) & mask;
+
+        ///older L, older R, newer L, newer R
+        auto older = _mm_loadu_ps (buffer + 2 * readIndex);
+        auto newer = _mm_movehl_ps (older, older);
+        auto delayed = _mm_add_ps (newer, _mm_mul_ps (_mm_set1_ps (delay - (float) whole), _mm_sub_ps (older, newer)));
+
+        tone = _mm_add_ps (tone, _mm_mul_ps (dampingV, _mm_sub_ps (delayed, tone)));
+
+        auto input = _mm_unpacklo_ps (_mm_load_ss (left + n), _mm_load_ss (right + n));
+        auto written = _mm_add_ps (input, _mm_mul_ps (feedbackV, tone));
+        _mm_storel_pi (reinterpret_cast<__m64*> (buffer + 2 * writeIndex), written);
+        _mm_storel_pi (reinterpret_cast<__m64*> (buffer + 2 * (writeIndex + capacity)), written);
+
+        auto output = _mm_add_ps (_mm_mul_ps (dryV, input), _mm_mul_ps (wetV, tone));
+        _mm_store_ss (left + n, output);
+        _mm_store_ss (right + n, _mm_shuffle_ps (output, output, _MM_SHUFFLE (1, 1, 1, 1)));
+
+        writeIndex = (writeIndex + 1) & mask;
+    }
+
+    alignas (16) float lanes[4];
+    _mm_store_ps (lanes, tone);
+    toneState[0] = lanes[0];
+    toneState[1] = lanes[1];
+   #elif AUTOEFFECT_USE_NEON
+    auto tone = vld1_f32 (toneState);
+
+    for (; n < numSamples; ++n)
+    {
+        auto delay = delaySamples.getNextValue();
+        auto whole = (int) delay;
+        auto readIndex = (writeIndex - whole - 1) & mask;
+
+        auto older = vld1_f32 (buffer + 2 * readIndex);
+        auto newer = vld1_f32 (buffer + 2 * readIndex + 2);
+        auto delayed = vmla_n_f32 (newer, vsub_f32 (older, newer), delay - (float) whole);
+
+        tone = vmla_n_f32 (tone, vsub_f32 (delayed, tone), damping);
+
+        auto input = vset_lane_f32 (right[n], vdup_n_f32 (left[n]), 1);
+        auto written = vmla_n_f32 (input, tone, feedback);
+        vst1_f32 (buffer + 2 * writeIndex, written);
+        vst1_f32 (buffer + 2 * (writeIndex + capacity), written);
+
+        auto output = vmla_n_f32 (vmul_n_f32 (input, dry), tone, wet);
+        left[n] = vget_lane_f32 (output, 0);
+        right[n] = vget_lane_f32 (output, 1);
+
+        writeIndex = (writeIndex + 1) & mask;
+    }
+
+    vst1_f32 (toneState, tone);
+   #endif
+
+    for (; n < numSamples; ++n)
+    {
+        auto delay = delaySamples.getNextValue();
+        auto whole = (int) delay;
+        auto fraction = delay - (float) whole;
+        auto* older = buffer + 2 * ((writeIndex - whole - 1) & mask);
+        const float input[2] = { left[n], right[n] };
+        float output[2];
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            auto delayed = older[channel + 2] + fraction * (older[channel] - older[channel + 2]);
+            toneState[channel] += damping * (delayed - toneState[channel]);
+
+            auto written = input[channel] + feedback * toneState[channel];
+            buffer[2 * writeIndex + channel] = written;
+            buffer[2 * (writeIndex + capacity) + channel] = written;
+
+            output[channel] = dry * input[channel] + wet * toneState[channel];
+        }
+
+        left[n] = output[0];
+        right[n] = output[1];
+
+        writeIndex = (writeIndex + 1) & mask;
+    }
+}
@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    StereoDelayLine.h
+    Created: 20 Oct 2026 8:41:15pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../Analysis/VectorKernels.h"
+
+//==============================================================================
+/**
+    Stereo delay with feedback and damped repeats, the engine of the delay effects.
+
+    Both channels share one interleaved circular buffer, so a left/right frame is read,
+    interpolated, filtered and written as a single SIMD value. The buffer holds a power of
+    two number of frames and every frame is written twice, at its index and one capacity
+    further: indices wrap with a mask and the two frames an interpolated read needs are
+    always next to each other, without any branch.
+
+    Delay time changes glide over a few milliseconds instead of jumping, and never
+    reallocate: the buffer is sized once in prepare() for the longest delay.
+*/
+class StereoDelayLine
+{
+public:
+    ///Above it the repeats would take too long to fade, or never would
+    static constexpr float maximumFeedback = 0.98f;
+
+    StereoDelayLine() = default;
+
+    ///Allocates, not on the audio thread. Clears the buffer
+    void prepare (double sampleRate, double maximumDelaySeconds);
+    void reset();
+
+    ///Clamped to the maximum given to prepare(), reached after the smoothing time
+    void setDelaySeconds (float seconds);
+    void setFeedback (float newFeedback)   { feedback = jlimit (0.f, maximumFeedback, newFeedback); }
+    void setMix (float newMix)             { mix = jlimit (0.f, 1.f, newMix); }
+
+    ///One-pole low pass on the repeats, 1 leaves them untouched, lower values darken every repeat a bit more
+    void setDamping (float coefficient)    { damping = jlimit (0.01f, 1.f, coefficient); }
+
+    /** In place. right may be the same pointer as left for a mono buffer. */
+    void process (float* left, float* right, int numSamples) noexcept;
+
+    int getCapacity() const noexcept       { return capacity; }
+    float getDelaySamples() const noexcept { return delaySamples.getTargetValue(); }
+
+private:
+    HeapBlock<float> frames;   ///2 * capacity interleaved frames, the second half mirrors the first
+    int capacity = 0;
+    int mask = 0;
+    int writeIndex = 0;
+
+    double sampleRate = 44100.0;
+    float maximumDelaySamples = 1.f;
+    float delaySeconds = 0.25f;
+
+    SmoothedValue<float> delaySamples { 1.f };
+    float feedback = 0.f;
+    float mix = 0.5f;
+    float damping = 1.f;
+    float toneState[2] = {};
+
+    static constexpr double delaySmoothingSeconds = 0.05;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StereoDelayLine)
+};
@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    Waveshaper.cpp
+    Created: 21 Oct 2026 2:36:08pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#include "Waveshaper.h"
+#include "SimdLanes.h"
+
+namespace Waveshaper
+{
+    float shape (float x, Curve curve) noexcept
+    {
+        x = jlimit (-1.f, 1.f, x);
+        auto x2 = x * x;
+
+        if (curve == Curve::cubic)
+            return x * (3.f - x2) * 0.5f;
+
+        return x * (15.f + x2 * (-10.f + x2 * 3.f)) * 0.125f;
+    }
+
+    template <Curve curve>
+    static void processCurve (float* samples, int numSamples, float drive, float outputGain) noexcept
+    {
+        const auto driveLanes = SimdLanes::broadcast (drive);
+        const auto one = SimdLanes::broadcast (1.f);
+        const auto minusOne = SimdLanes::broadcast (-1.f);
+        int i = 0;
+
+        if constexpr (curve == Curve::cubic)
+        {
+            const auto three = SimdLanes::broadcast (3.f);
+            const auto scale = SimdLanes::broadcast (0.5f * outputGain);
+
+            for (; i + 4 <= numSamples; i += 4)
+            {
+                auto x = SimdLanes::min (one, SimdLanes::max (minusOne, SimdLanes::load (samples + i) * driveLanes));
+                (x * (three - x * x) * scale).store (samples + i);
+            }
+        }
+        else
+        {
+            const auto c0 = SimdLanes::broadcast (15.f);
+            const auto c2 = SimdLanes::broadcast (-10.f);
+            const auto c4 = SimdLanes::broadcast (3.f);
+            const auto scale = SimdLanes::broadcast (0.125f * outputGain);
+
+            for (; i + 4 <= numSamples; i += 4)
+            {
+                auto x = SimdLanes::min (one, SimdLanes::max (minusOne, SimdLanes::load (samples + i) * driveLanes));
+                auto x2 = x * x;
+                (x * (c0 + x2 * (c2 + x2 * c4)) * scale).store (samples + i);
+            }
+        }
+
+        for (; i < numSamples; ++i)
+            samples[i] = outputGain * shape (drive * samples[i], curve);
+    }
+
+    void process (float* samples, int numSamples, Curve curve, float drive, float outputGain) noexcept
+    {
+        if (curve == Curve::cubic)
+            processCurve<Curve::cubic> (samples, numSamples, drive, outputGain);
+        else
+            processCurve<Curve::quintic> (samples, numSamples, drive, outputGain);
+    }
+}
@@ -0,0 +1,37 @@
+/*
+  ==============================================================================
+
+    Waveshaper.h
+    Created: 21 Oct 2026 2:36:08pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../Analysis/VectorKernels.h"
+
+//==============================================================================
+/**
+    Memoryless soft clipping curves, evaluated four samples at a time.
+
+    Both are odd polynomials of the driven input clamped to [-1, 1], with a zero
+    slope at the clamp so there is no corner. Their harmonics stay small above the
+    degree of the polynomial, so the cubic needs less oversampling than the quintic
+    for the same aliasing.
+*/
+namespace Waveshaper
+{
+    enum class Curve
+    {
+        cubic,      ///x (3 - x^2) / 2, a gentle knee
+        quintic     ///x (15 - 10 x^2 + 3 x^4) / 8, flatter until a harder knee
+    };
+
+    ///One sample, the reference the vector loop must match
+    float shape (float x, Curve curve) noexcept;
+
+    ///outputGain * shape (drive * x) for every sample, in place
+    void process (float* samples, int numSamples, Curve curve, float drive, float outputGain) noexcept;
+}
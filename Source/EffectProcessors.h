@@ -11,6 +11,15 @@
 #pragma once
 
 #include "CustomJuceHeader.h"
+#include "DSP/StereoDelayLine.h"
+#include "DSP/FeedbackDelayNetwork.h"
+#include "DSP/Waveshaper.h"
+#include "DSP/ModulationCore.h"
+#include "DSP/ModulatedDelayLine.h"
+#include "DSP/AllpassCascade.h"
+
+#include <type_traits>
+#include <variant>
 
 enum EffectEnum {
     Dry = 0,
@@ -26,6 +35,9 @@ enum EffectEnum {
     Overdrive
 };
 
+///Number of classes the classifier can return
+static constexpr int numberOfEffects = EffectEnum::Overdrive + 1;
+
 //==============================================================================
 class ProcessorBase  : public juce::AudioProcessor
 {
@@ -167,3 +179,613 @@ private:
     float feedback = 0.f;
     float mix = 0.75f;
 };
+
+//==============================================================================
+/** Both delay effects, which only differ by their settings. Any delay time up to the
+    maximum given to the constructor can be set while playing, nothing is reallocated.
+*/
+class DelayProcessor  : public ProcessorBase
+{
+public:
+    DelayProcessor (float timeSeconds, float feedbackAmount, float mixAmount, float dampingAmount, float maximumSeconds)
+        : maximumTime (maximumSeconds)
+    {
+        setTime (timeSeconds);
+        setFeedback (feedbackAmount);
+        setMix (mixAmount);
+        setDamping (dampingAmount);
+    }
+
+    void prepareToPlay (double sampleRate, int) override
+    {
+        delay.prepare (sampleRate, maximumTime);
+    }
+
+    void processBlock (juce::AudioSampleBuffer& buffer, juce::MidiBuffer&) override
+    {
+        if (buffer.getNumChannels() == 0)
+            return;
+
+        auto* left = buffer.getWritePointer (0);
+        auto* right = buffer.getNumChannels() > 1 ? buffer.getWritePointer (1) : left;
+        delay.process (left, right, buffer.getNumSamples());
+    }
+
+    void reset() override
+    {
+        delay.reset();
+    }
+
+    ///Until the repeats are 60 dB down
+    double getTailLengthSeconds() const override
+    {
+        auto numRepeats = feedback > 0.f ? std::log (0.001) / std::log ((double) feedback) : 0.0;
+        return time * (1.0 + numRepeats);
+    }
+
+    void setTime(float seconds) {
+        time = jlimit(0.001f, maximumTime, seconds);
+        delay.setDelaySeconds(time);
+    }
+    ///Clamped to what the delay line plays, so the tail is computed for the actual repeats
+    void setFeedback(float value) {
+        feedback = jlimit(0.f, StereoDelayLine::maximumFeedback, value);
+        delay.setFeedback(feedback);
+    }
+    void setMix(float value) {
+        mix = value;
+        delay.setMix(value);
+    }
+    void setDamping(float value) {
+        damping = value;
+        delay.setDamping(value);
+    }
+
+    float getTime() { return time; }
+    float getFeedback() { return feedback; }
+    float getMix() { return mix; }
+    float getDamping() { return damping; }
+    float getMaximumTime() { return maximumTime; }
+
+private:
+    StereoDelayLine delay;
+
+    const float maximumTime;
+    float time = 0.f;
+    float feedback = 0.f;
+    float mix = 0.f;
+    float damping = 1.f;
+};
+
+//==============================================================================
+class FeedBackDelayProcessor final  : public DelayProcessor
+{
+public:
+    FeedBackDelayProcessor() : DelayProcessor (0.375f, 0.45f, 0.35f, 0.6f, 2.f) {}
+
+    const juce::String getName() const override { return "FeedBack Delay"; }
+};
+
+//==============================================================================
+///A single short repeat, kept brighter than the feedback delay ones
+class SlapbackDelayProcessor final  : public DelayProcessor
+{
+public:
+    SlapbackDelayProcessor() : DelayProcessor (0.09f, 0.f, 0.4f, 0.9f, 0.25f) {}
+
+    const juce::String getName() const override { return "Slapback Delay"; }
+};
+
+//==============================================================================
+class ReverbProcessor final  : public ProcessorBase
+{
+public:
+    ReverbProcessor() {
+        setDecayTime(decayTime);
+        setSize(size);
+        setDamping(damping);
+        setMix(mix);
+    }
+
+    void prepareToPlay (double sampleRate, int) override
+    {
+        reverb.prepare (sampleRate);
+    }
+
+    void processBlock (juce::AudioSampleBuffer& buffer, juce::MidiBuffer&) override
+    {
+        if (buffer.getNumChannels() == 0)
+            return;
+
+        auto* left = buffer.getWritePointer (0);
+        auto* right = buffer.getNumChannels() > 1 ? buffer.getWritePointer (1) : left;
+        reverb.process (left, right, buffer.getNumSamples());
+    }
+
+    void reset() override
+    {
+        reverb.reset();
+    }
+
+    double getTailLengthSeconds() const override { return reverb.getTailLengthSeconds(); }
+
+    void setDecayTime(float seconds) {
+        decayTime = seconds;
+        reverb.setDecayTime(seconds);
+    }
+    void setSize(float value) {
+        size = value;
+        reverb.setSize(value);
+    }
+    void setDamping(float value) {
+        damping = value;
+        reverb.setDamping(value);
+    }
+    void setMix(float value) {
+        mix = value;
+        reverb.setMix(value);
+    }
+
+    float getDecayTime() { return decayTime; }
+    float getSize() { return size; }
+    float getDamping() { return damping; }
+    float getMix() { return mix; }
+
+    const juce::String getName() const override { return "Reverb"; }
+
+private:
+    FeedbackDelayNetwork reverb;
+
+    float decayTime = 1.8f;
+    float size = 1.f;
+    float damping = 0.4f;
+    float mix = 0.3f;
+};
+
+//==============================================================================
+/** Both clipping effects. The curve runs at the session rate times the oversampling
+    factor, so the harmonics it creates above the session Nyquist are filtered out
+    instead of folding back as aliasing.
+
+    One oversampler per factor is created in prepareToPlay(), the factor can then be
+    changed while playing without allocating. Each adds its own latency, reported as
+    the latency of the processor.
+*/
+class WaveshaperProcessor  : public ProcessorBase
+{
+public:
+    ///1x, 2x, 4x, 8x and 16x
+    static constexpr int maximumOversamplingOrder = 4;
+    static constexpr int maximumOversamplingFactor = 1 << maximumOversamplingOrder;
+
+    WaveshaperProcessor (Waveshaper::Curve curveToUse, float driveAmount, float outputGainAmount)
+        : curve (curveToUse)
+    {
+        setDrive (driveAmount);
+        setOutputGain (outputGainAmount);
+    }
+
+    void prepareToPlay (double, int samplesPerBlock) override
+    {
+        oversamplers.clear();
+
+        for (int order = 1; order <= maximumOversamplingOrder; ++order)
+        {
+            auto* oversampler = oversamplers.add (new juce::dsp::Oversampling<float> ((size_t) jmax (1, getTotalNumInputChannels()), (size_t) order,
+                                                                                     juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR,
+                                                                                     true, true));
+            oversampler->initProcessing ((size_t) samplesPerBlock);
+        }
+
+        activeOrder = -1;
+        updateLatency();
+    }
+
+    void processBlock (juce::AudioSampleBuffer& buffer, juce::MidiBuffer&) override
+    {
+        auto order = oversamplingOrder.load (std::memory_order_relaxed);
+
+        ///The filters of the new factor still hold whatever they saw when it was last used
+        if (order != activeOrder)
+        {
+            if (order > 0)
+                oversamplers.getUnchecked (order - 1)->reset();
+            activeOrder = order;
+        }
+
+        juce::dsp::AudioBlock<float> block (buffer);
+
+        if (order == 0)
+        {
+            shape (block);
+            return;
+        }
+
+        auto* oversampler = oversamplers.getUnchecked (order - 1);
+        shape (oversampler->processSamplesUp (block));
+        oversampler->processSamplesDown (block);
+    }
+
+    void reset() override
+    {
+        for (auto* oversampler : oversamplers)
+            oversampler->reset();
+    }
+
+    ///Rounded down to a power of two in [1, 16]. Message thread, updates the latency
+    void setOversamplingFactor(int factor) {
+        oversamplingOrder = jlimit(0, maximumOversamplingOrder, (int) std::log2(jmax(1, factor)));
+        updateLatency();
+    }
+    void setDrive(float value) {
+        drive = jlimit(1.f, 100.f, value);
+    }
+    void setOutputGain(float value) {
+        outputGain = jlimit(0.f, 1.f, value);
+    }
+
+    int getOversamplingFactor() { return 1 << oversamplingOrder.load(); }
+    float getDrive() { return drive; }
+    float getOutputGain() { return outputGain; }
+
+private:
+    void shape (const juce::dsp::AudioBlock<float>& block) noexcept
+    {
+        for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+            Waveshaper::process (block.getChannelPointer (channel), (int) block.getNumSamples(), curve, drive, outputGain);
+    }
+
+    ///Integer latency was asked for, the oversamplers add a fractional delay to get it
+    void updateLatency()
+    {
+        auto order = oversamplingOrder.load();
+        auto* oversampler = order > 0 ? oversamplers[order - 1] : nullptr;
+        setLatencySamples (oversampler != nullptr ? roundToInt (oversampler->getLatencyInSamples()) : 0);
+    }
+
+    const Waveshaper::Curve curve;
+    juce::OwnedArray<juce::dsp::Oversampling<float>> oversamplers;   ///Factor 2 to the maximum, in order
+
+    std::atomic<int> oversamplingOrder { 0 };
+    int activeOrder = -1;   ///Audio thread
+
+    float drive = 1.f;
+    float outputGain = 1.f;
+};
+
+//==============================================================================
+///Pushed hard into the flat top of the quintic curve, close to a square wave
+class DistortionProcessor final  : public WaveshaperProcessor
+{
+public:
+    DistortionProcessor() : WaveshaperProcessor (Waveshaper::Curve::quintic, 20.f, 0.5f) {}
+
+    const juce::String getName() const override { return "Distortion"; }
+};
+
+//==============================================================================
+///Driven just past the knee of the cubic curve, quiet parts stay almost clean
+class OverdriveProcessor final  : public WaveshaperProcessor
+{
+public:
+    OverdriveProcessor() : WaveshaperProcessor (Waveshaper::Curve::cubic, 4.f, 0.7f) {}
+
+    const juce::String getName() const override { return "Overdrive"; }
+};
+
+//==============================================================================
+/** The LFO part of the modulation effects, one LFO per channel.
+
+    Alone, the processor runs a ModulationCore of its own. In a chain, shareCore()
+    moves its LFOs to the core of the chain, which evaluates the LFOs of every
+    modulation effect together once per block.
+*/
+class ModulationProcessor  : public ProcessorBase
+{
+public:
+    static constexpr int numLfos = 2;
+
+    void prepareToPlay (double sampleRate, int samplesPerBlock) override
+    {
+        if (core == &ownCore)
+        {
+            ownCore.prepare (sampleRate, samplesPerBlock, numLfos);
+            addLfosTo (ownCore);
+        }
+    }
+
+    void reset() override
+    {
+        for (auto lfo : lfos)
+            if (lfo >= 0)
+                core->resetPhase (lfo);
+    }
+
+    ///Not on the audio thread, after prepareToPlay. The owner of the core advances it before every block
+    void shareCore(ModulationCore& sharedCore) {
+        core = &sharedCore;
+        addLfosTo(sharedCore);
+    }
+
+    void setRate(float hz) {
+        rate = hz;
+        for (auto lfo : lfos)
+            if (lfo >= 0)
+                core->setRate(lfo, hz);
+    }
+
+    float getRate() { return rate; }
+
+protected:
+    ///stereoPhase is how far the right LFO is ahead of the left one, in cycles
+    ModulationProcessor (float rateHz, float stereoPhaseOffset)
+        : rate (rateHz), stereoPhase (stereoPhaseOffset)
+    {}
+
+    ///Start of processBlock, before reading any LFO value
+    void advanceLfos (int numSamples) noexcept
+    {
+        if (core == &ownCore)
+            ownCore.advance (numSamples);
+    }
+
+    const float* getLfoValues (int channel) const noexcept   { return core->getValues (lfos[jmin (channel, numLfos - 1)]); }
+
+private:
+    void addLfosTo (ModulationCore& target)
+    {
+        for (int channel = 0; channel < numLfos; ++channel)
+            lfos[channel] = target.addLfo (rate, (float) channel * stereoPhase);
+    }
+
+    ModulationCore ownCore;
+    ModulationCore* core = &ownCore;
+    int lfos[numLfos] = { -1, -1 };
+
+    float rate;
+    const float stereoPhase;
+};
+
+//==============================================================================
+class TremoloProcessor final  : public ModulationProcessor
+{
+public:
+    TremoloProcessor() : ModulationProcessor (5.f, 0.f) {}
+
+    void processBlock (juce::AudioSampleBuffer& buffer, juce::MidiBuffer&) override
+    {
+        auto numSamples = buffer.getNumSamples();
+        advanceLfos (numSamples);
+
+        ///Gain from 1 at the top of the LFO down to 1 - depth at the bottom
+        const auto centre = 1.f - 0.5f * depth;
+        const auto swing = 0.5f * depth;
+
+        for (int channel = 0; channel < jmin (2, buffer.getNumChannels()); ++channel)
+        {
+            auto* samples = buffer.getWritePointer (channel);
+            const auto* lfo = getLfoValues (channel);
+
+            for (int i = 0; i < numSamples; ++i)
+                samples[i] *= centre + swing * lfo[i];
+        }
+    }
+
+    void setDepth(float value) {
+        depth = jlimit(0.f, 1.f, value);
+    }
+
+    float getDepth() { return depth; }
+
+    const juce::String getName() const override { return "Tremolo"; }
+
+private:
+    float depth = 0.5f;
+};
+
+//==============================================================================
+/** Flanger and vibrato, a short delay swept by the LFO. The flanger mixes it with the
+    dry signal and feeds it back, the vibrato only keeps the delayed signal.
+*/
+class ModulatedDelayProcessor  : public ModulationProcessor
+{
+public:
+    ModulatedDelayProcessor (float rateHz, float stereoPhaseOffset, float centreMs, float depthMs, float feedbackAmount, float mixAmount)
+        : ModulationProcessor (rateHz, stereoPhaseOffset)
+    {
+        setCentreDelay (centreMs);
+        setDepth (depthMs);
+        setFeedback (feedbackAmount);
+        setMix (mixAmount);
+    }
+
+    void prepareToPlay (double sampleRate, int samplesPerBlock) override
+    {
+        ModulationProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+        samplesPerMs = (float) sampleRate * 0.001f;
+
+        for (auto& line : lines)
+            line.prepare (sampleRate, maximumDelayMs * 0.001);
+    }
+
+    void processBlock (juce::AudioSampleBuffer& buffer, juce::MidiBuffer&) override
+    {
+        auto numSamples = buffer.getNumSamples();
+        advanceLfos (numSamples);
+
+        for (int channel = 0; channel < jmin (2, buffer.getNumChannels()); ++channel)
+            lines[channel].process (buffer.getWritePointer (channel), getLfoValues (channel), numSamples,
+                                    centreDelay * samplesPerMs, depth * samplesPerMs, feedback, mix);
+    }
+
+    void reset() override
+    {
+        ModulationProcessor::reset();
+
+        for (auto& line : lines)
+            line.reset();
+    }
+
+    ///Until the repeats are 60 dB down
+    double getTailLengthSeconds() const override
+    {
+        auto numRepeats = feedback > 0.f ? std::log (0.001) / std::log ((double) feedback) : 0.0;
+        return (centreDelay + depth) * 0.001 * (1.0 + numRepeats);
+    }
+
+    void setCentreDelay(float ms) {
+        centreDelay = jlimit(0.1f, maximumDelayMs, ms);
+    }
+    void setDepth(float ms) {
+        depth = jmax(0.f, ms);
+    }
+    void setFeedback(float value) {
+        feedback = jlimit(0.f, 0.95f, value);
+    }
+    void setMix(float value) {
+        mix = jlimit(0.f, 1.f, value);
+    }
+
+    float getCentreDelay() { return centreDelay; }
+    float getDepth() { return depth; }
+    float getFeedback() { return feedback; }
+    float getMix() { return mix; }
+
+private:
+    static constexpr float maximumDelayMs = 20.f;
+
+    ModulatedDelayLine lines[2];
+    float samplesPerMs = 44.1f;
+
+    float centreDelay = 0.f;
+    float depth = 0.f;
+    float feedback = 0.f;
+    float mix = 0.f;
+};
+
+//==============================================================================
+///Slow sweep with the channels a quarter cycle apart, which makes it move across the stereo field
+class FlangerProcessor final  : public ModulatedDelayProcessor
+{
+public:
+    FlangerProcessor() : ModulatedDelayProcessor (0.25f, 0.25f, 3.5f, 2.5f, 0.6f, 0.5f) {}
+
+    const juce::String getName() const override { return "Flanger"; }
+};
+
+//==============================================================================
+///About a quarter tone of pitch swing
+class VibratoProcessor final  : public ModulatedDelayProcessor
+{
+public:
+    VibratoProcessor() : ModulatedDelayProcessor (5.f, 0.f, 5.f, 0.5f, 0.f, 1.f) {}
+
+    const juce::String getName() const override { return "Vibrato"; }
+};
+
+//==============================================================================
+class PhaserProcessor final  : public ModulationProcessor
+{
+public:
+    PhaserProcessor() : ModulationProcessor (0.4f, 0.25f) {
+        for (auto& cascade : cascades)
+            cascade.setRange(lowestFrequency, highestFrequency);
+    }
+
+    void prepareToPlay (double sampleRate, int samplesPerBlock) override
+    {
+        ModulationProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
+        for (auto& cascade : cascades)
+            cascade.prepare (sampleRate);
+    }
+
+    void processBlock (juce::AudioSampleBuffer& buffer, juce::MidiBuffer&) override
+    {
+        auto numSamples = buffer.getNumSamples();
+        advanceLfos (numSamples);
+
+        for (int channel = 0; channel < jmin (2, buffer.getNumChannels()); ++channel)
+            cascades[channel].process (buffer.getWritePointer (channel), getLfoValues (channel), numSamples, feedback, mix);
+    }
+
+    void reset() override
+    {
+        ModulationProcessor::reset();
+
+        for (auto& cascade : cascades)
+            cascade.reset();
+    }
+
+    void setFeedback(float value) {
+        feedback = jlimit(0.f, 0.9f, value);
+    }
+    void setMix(float value) {
+        mix = jlimit(0.f, 1.f, value);
+    }
+
+    float getFeedback() { return feedback; }
+    float getMix() { return mix; }
+
+    const juce::String getName() const override { return "Phaser"; }
+
+private:
+    static constexpr float lowestFrequency = 200.f;
+    static constexpr float highestFrequency = 2500.f;
+
+    AllpassCascade cascades[2];
+
+    float feedback = 0.6f;
+    float mix = 0.5f;
+};
+
+//==============================================================================
+/** Calls visitor with a std::type_identity of the processor class that runs the effect,
+    or of std::monostate for Dry, which leaves the audio untouched.
+    The only place mapping effects to processors, every chain engine builds from it.
+*/
+template <typename Visitor>
+decltype (auto) visitEffectType (EffectEnum effect, Visitor&& visitor)
+{
+    switch (effect)
+    {
+        case EffectEnum::FeedBackDelay:
+            return visitor (std::type_identity<FeedBackDelayProcessor>{});
+        case EffectEnum::SlapbackDelay:
+            return visitor (std::type_identity<SlapbackDelayProcessor>{});
+        case EffectEnum::Reverb:
+            return visitor (std::type_identity<ReverbProcessor>{});
+        case EffectEnum::Flanger:
+            return visitor (std::type_identity<FlangerProcessor>{});
+        case EffectEnum::Phaser:
+            return visitor (std::type_identity<PhaserProcessor>{});
+        case EffectEnum::Tremolo:
+            return visitor (std::type_identity<TremoloProcessor>{});
+        case EffectEnum::Vibrato:
+            return visitor (std::type_identity<VibratoProcessor>{});
+        case EffectEnum::Distortion:
+            return visitor (std::type_identity<DistortionProcessor>{});
+        case EffectEnum::Overdrive:
+            return visitor (std::type_identity<OverdriveProcessor>{});
+        case EffectEnum::Chorus:
+            return visitor (std::type_identity<ChorusProcessor>{});
+
+        case EffectEnum::Dry:
+        default:
+            return visitor (std::type_identity<std::monostate>{});
+    }
+}
+
+///A new processor for the effect, nullptr for Dry
+inline std::unique_ptr<juce::AudioProcessor> createEffectProcessor (EffectEnum effect)
+{
+    return visitEffectType (effect, [] (auto type) -> std::unique_ptr<juce::AudioProcessor>
+    {
+        using Effect = typename decltype (type)::type;
+
+        if constexpr (std::is_same_v<Effect, std::monostate>)
+            return nullptr;
+        else
+            return std::make_unique<Effect>();
+    });
+}
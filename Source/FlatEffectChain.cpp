@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    FlatEffectChain.cpp
+    Created: 20 Oct 2026 6:03:47pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#include "FlatEffectChain.h"
+
+FlatEffectChain::FlatEffectChain (const Array<EffectEnum>& effects, int numChannels, double sampleRate, int maximumBlockSize)
+    : slots (new Slot[(size_t) jmax (1, effects.size())]), numEffects (effects.size())
+{
+    for (int i = 0; i < numEffects; ++i)
+    {
+        auto* processor = visitEffectType (effects[i], [&] (auto type) -> AudioProcessor*
+        {
+            using Effect = typename decltype (type)::type;
+
+            ///Dry leaves its slot empty, process() skips it
+            if constexpr (std::is_same_v<Effect, std::monostate>)
+                return nullptr;
+            else
+                return &slots[(size_t) i].template emplace<Effect>();
+        });
+
+        if (processor == nullptr)
+            continue;
+
+        processor->setPlayConfigDetails (numChannels, numChannels, sampleRate, maximumBlockSize);
+        processor->enableAllBuses();
+        processor->prepareToPlay (sampleRate, maximumBlockSize);
+    }
+}
+
+FlatEffectChain::~FlatEffectChain()
+{
+    for (int i = 0; i < numEffects; ++i)
+        if (auto* processor = getEffectProcessor (i))
+            processor->releaseResources();
+}
+
+void FlatEffectChain::process (AudioBuffer<float>& buffer, MidiBuffer& midiMessages) noexcept
+{
+    for (int i = 0; i < numEffects; ++i)
+    {
+        std::visit ([&] (auto& effect)
+        {
+            using Effect = std::decay_t<decltype (effect)>;
+
+            ///Qualified, so the compiler calls the concrete processBlock directly instead of going through the vtable
+            if constexpr (! std::is_same_v<Effect, std::monostate>)
+                effect.Effect::processBlock (buffer, midiMessages);
+        }, slots[(size_t) i]);
+    }
+}
+
+AudioProcessor* FlatEffectChain::getEffectProcessor (int index) const
+{
+    if (!isPositiveAndBelow (index, numEffects))
+        return nullptr;
+
+    return std::visit ([] (auto& effect) -> AudioProcessor*
+    {
+        if constexpr (std::is_same_v<std::decay_t<decltype (effect)>, std::monostate>)
+            return nullptr;
+        else
+            return &effect;
+    }, slots[(size_t) index]);
+}
@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    FlatEffectChain.h
+    Created: 20 Oct 2026 6:03:47pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "EffectProcessors.h"
+
+#include <variant>
+
+//==============================================================================
+/**
+    Linear effect chain without a graph: the effects sit next to each other in one
+    array and process the host buffer in place, one after the other.
+
+    Every slot is a variant over the concrete processor classes, and processBlock is
+    called through std::visit with a qualified name, so there is no virtual call, no
+    intermediate buffer, no MIDI routing and no rendering sequence to build. Unlike
+    a graph, it can be built and prepared on any thread.
+*/
+class FlatEffectChain
+{
+public:
+    ///Every processor visitEffectType() can return, std::monostate for Dry or until a slot is filled
+    using Slot = std::variant<std::monostate, ChorusProcessor, FeedBackDelayProcessor, SlapbackDelayProcessor,
+                              ReverbProcessor, DistortionProcessor, OverdriveProcessor, FlangerProcessor,
+                              PhaserProcessor, TremoloProcessor, VibratoProcessor>;
+
+    FlatEffectChain (const Array<EffectEnum>& effects, int numChannels, double sampleRate, int maximumBlockSize);
+    ~FlatEffectChain();
+
+    ///Audio thread
+    void process (AudioBuffer<float>& buffer, MidiBuffer& midiMessages) noexcept;
+
+    int getNumEffects() const noexcept  { return numEffects; }
+
+    ///Valid as long as the chain, nullptr if the index is out of range
+    AudioProcessor* getEffectProcessor (int index) const;
+
+private:
+    ///Allocated once, slots can't move since processors can't
+    std::unique_ptr<Slot[]> slots;
+    const int numEffects;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlatEffectChain)
+};
@@ -27,6 +27,25 @@ AutoEffectsAudioProcessorEditor::AutoEffectsAudioProcessorEditor (AutoEffectsAud
     cancelButton->setImages(false, true, true, ImageCache::getFromMemory (BinaryData::icon_cancel_png, BinaryData::icon_cancel_pngSize), 1.f, Colour (77,94,251), juce::Image(), 1.000f, juce::Colour (77,94,251), ImageCache::getFromMemory (BinaryData::icon_cancel_png, BinaryData::icon_cancel_pngSize), 1.f, Colour (32,42,131));
     cancelButton->setBounds(3, 3, 25, 25);
     
+    liveButton.reset (new juce::ToggleButton (TRANS("Live input")));
+    addAndMakeVisible (liveButton.get());
+    liveButton->addListener (this);
+    liveButton->setToggleState (audioProcessor.getLiveAnalysisSettings().enabled, dontSendNotification);
+    liveButton->setColour (juce::ToggleButton::textColourId, Colour(113,114,123));
+    liveButton->setColour (juce::ToggleButton::tickColourId, Colour (77,94,251));
+    
+    liveLabel.reset (new juce::Label ("liveLabel", {}));
+    addAndMakeVisible (liveLabel.get());
+    liveLabel->setFont (juce::Font (13.00f, juce::Font::plain).withTypefaceStyle ("Regular"));
+    liveLabel->setJustificationType (juce::Justification::centredLeft);
+    liveLabel->setColour (juce::Label::textColourId, Colour(113,114,123));
+    
+    timingsButton.reset (new juce::ToggleButton (TRANS("Timings")));
+    addAndMakeVisible (timingsButton.get());
+    timingsButton->addListener (this);
+    timingsButton->setColour (juce::ToggleButton::textColourId, Colour(113,114,123));
+    timingsButton->setColour (juce::ToggleButton::tickColourId, Colour (77,94,251));
+    
     dropFileLabel.reset (new juce::Label ("dropLabel", TRANS("Drop your target sound here to process")));
     addAndMakeVisible (dropFileLabel.get());
     dropFileLabel->setFont (juce::Font (15.00f, juce::Font::plain).withTypefaceStyle ("Regular"));
@@ -65,6 +84,11 @@ AutoEffectsAudioProcessorEditor::AutoEffectsAudioProcessorEditor (AutoEffectsAud
     loadingWaitingScreen->setAlwaysOnTop(true);
     loadingWaitingScreen->setVisible(false);
     
+    timingOverlay.reset(new TimingOverlay());
+    addChildComponent(timingOverlay.get());
+    timingOverlay->setAlwaysOnTop(true);
+    timingOverlay->onExport = [this] { exportTimings(); };
+    
     using Track = juce::Grid::TrackInfo;
     Array<ExceptionGrid> params;
     
@@ -78,26 +102,37 @@ AutoEffectsAudioProcessorEditor::AutoEffectsAudioProcessorEditor (AutoEffectsAud
     addAndMakeVisible(*mainGrid);
     params.clear();
     
+    updateModelStateLabel();
+    updateLiveLabel();
+    
+    ///Analyses may have been started by a previous editor, results are then pushed to this one
+    audioProcessor.addAnalysisListener(this);
+    updateProcessingState();
+    
     setSize (400, 300);
+    updateEffectBlocks();
     
     getLookAndFeel().setUsingNativeAlertWindows(true);
-    
-    startTimer(50.);
 }
 
 AutoEffectsAudioProcessorEditor::~AutoEffectsAudioProcessorEditor()
 {
+    audioProcessor.removeAnalysisListener(this);
+    
     dropFileLabel = nullptr;
     dropFileLabel2 = nullptr;
     dropImage = nullptr;
     browseFileButton = nullptr;
     cancelButton = nullptr;
+    liveButton = nullptr;
+    liveLabel = nullptr;
+    timingsButton = nullptr;
+    timingOverlay = nullptr;
+    timingsChooser = nullptr;
     
     dropZone = nullptr;
     loadingWaitingScreen = nullptr;
     chorusBlock = nullptr;
-    
-    stopTimer();
 }
 
 //==============================================================================
@@ -116,6 +151,12 @@ void AutoEffectsAudioProcessorEditor::resized()
     loadingWaitingScreen->setBounds(bounds);
     
     auto reducedBound = bounds.reduced(30);
+    
+    auto liveArea = bounds.withTop(reducedBound.getBottom()).reduced(30, 3);
+    liveButton->setBounds(liveArea.removeFromLeft(100));
+    timingsButton->setBounds(liveArea.removeFromRight(80));
+    liveLabel->setBounds(liveArea);
+    timingOverlay->setBounds(reducedBound);
     mainGrid->setBounds(reducedBound);
     dropZone->setBounds(reducedBound);
     if (!showEffects) {
@@ -132,16 +173,92 @@ void AutoEffectsAudioProcessorEditor::resized()
     }
 }
 
+void AutoEffectsAudioProcessorEditor::updateModelStateLabel()
+{
+    switch (audioProcessor.getModelState()) {
+        case AutoEffectsAudioProcessor::Loading:
+            dropFileLabel->setText(TRANS("Loading classifier, files dropped now will wait"), dontSendNotification);
+            break;
+        case AutoEffectsAudioProcessor::Ready:
+            dropFileLabel->setText(TRANS("Drop your target sound here to process"), dontSendNotification);
+            break;
+        case AutoEffectsAudioProcessor::Unavailable:
+            dropFileLabel->setText(TRANS("Classifier couldn't be loaded"), dontSendNotification);
+            break;
+    }
+}
+
+void AutoEffectsAudioProcessorEditor::updateProcessingState()
+{
+    auto processing = audioProcessor.getProcessState() == AutoEffectsAudioProcessor::Process;
+    
+    if (processing == loadingWaitingScreen->isVisible())
+        return;
+    
+    loadingWaitingScreen->setVisible(processing);
+    
+    if (processing)
+        loadingWaitingScreen->startAnimation();
+    else
+        loadingWaitingScreen->stopAnimation();
+}
+
+void AutoEffectsAudioProcessorEditor::analyseFiles(const StringArray& files)
+{
+    for (int i = 0; i < files.size(); ++i)
+        audioProcessor.analyseAsync(File(files[i]), {}, i == 0);
+    
+    updateProcessingState();
+}
+
+void AutoEffectsAudioProcessorEditor::updateLiveLabel()
+{
+    if (!audioProcessor.getLiveAnalysisSettings().enabled) {
+        liveLabel->setText({}, dontSendNotification);
+        return;
+    }
+    
+    auto state = audioProcessor.getLiveAnalysisState();
+    
+    if (state.numWindows == 0)
+        liveLabel->setText(TRANS("Listening..."), dontSendNotification);
+    else
+        liveLabel->setText(nameFromEffectEnum(state.effect) + " (" + String(state.score, 2) + ")", dontSendNotification);
+}
+
 void AutoEffectsAudioProcessorEditor::buttonClicked (juce::Button* buttonThatWasClicked)
 {
     if (buttonThatWasClicked == cancelButton.get()) {
         audioProcessor.resetPlugin();
+    } else if (buttonThatWasClicked == liveButton.get()) {
+        auto settings = audioProcessor.getLiveAnalysisSettings();
+        settings.enabled = liveButton->getToggleState();
+        audioProcessor.setLiveAnalysisSettings(settings);
+        updateLiveLabel();
+    } else if (buttonThatWasClicked == timingsButton.get()) {
+        if (timingsButton->getToggleState())
+            timingOverlay->setRecords(audioProcessor.getAnalysisTimings());
+        timingOverlay->setVisible(timingsButton->getToggleState());
     }
 }
 
+void AutoEffectsAudioProcessorEditor::exportTimings()
+{
+    timingsChooser.reset(new FileChooser(TRANS("Export analysis timings"),
+                                         File::getSpecialLocation(File::userDocumentsDirectory).getChildFile("AutoEffectsTimings.csv"),
+                                         "*.csv;*.json"));
+    
+    timingsChooser->launchAsync(FileBrowserComponent::saveMode | FileBrowserComponent::canSelectFiles | FileBrowserComponent::warnAboutOverwriting,
+                                [this] (const FileChooser& chooser) {
+        auto destination = chooser.getResult();
+        
+        if (destination != File() && !audioProcessor.exportAnalysisTimings(destination))
+            AlertWindow::showMessageBoxAsync (AlertWindow::WarningIcon, TRANS("Export failed"), TRANS("Couldn't write to ") + destination.getFullPathName());
+    });
+}
+
 void AutoEffectsAudioProcessorEditor::selectFileButtonDidSelectNewFiles(SelectFileButton* button, StringArray files, Array<URL> /*urls*/)
 {
-    if (button == browseFileButton.get()) {
-        audioProcessor.setTargetToProcess(File(files[0]));
-    }
+    if (button == browseFileButton.get())
+        analyseFiles(files);
 }
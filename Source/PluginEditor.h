@@ -11,6 +11,7 @@
 #include "PluginProcessor.h"
 #include "dropFileZone.h"
 #include "UI/LoadingWaitingScreen.h"
+#include "UI/TimingOverlay.h"
 #include "UI/EffectBlocks.h"
 #include "UIElements/SelectFileButton.h"
 
@@ -18,10 +19,10 @@
 /**
 */
 class AutoEffectsAudioProcessorEditor  : public juce::AudioProcessorEditor,
-                                         public juce::Timer,
                                          public juce::Button::Listener,
                                          public SelectFileButton::Listener,
-                                         public dropFileZone::Listener
+                                         public dropFileZone::Listener,
+                                         public AutoEffectsAudioProcessor::AnalysisListener
 {
 public:
     AutoEffectsAudioProcessorEditor (AutoEffectsAudioProcessor&);
@@ -31,10 +32,6 @@ public:
     void paint (juce::Graphics&) override;
     void resized() override;
     
-    //==============================================================================
-    // MARK: - Timer class methods
-    //==============================================================================
-
     String nameFromEffectEnum(EffectEnum value)
     {
         switch (value) {
@@ -63,41 +60,54 @@ public:
         }
     }
     
-    void timerCallback() override
+    ///Called by the processor each time it publishes a chain, the blocks must not outlive the processors of the previous one
+    void updateEffectBlocks()
     {
-        if (audioProcessor.UIupdate_processing) {
-            audioProcessor.UIupdate_processing = false;
-            
-            int state = audioProcessor.getProcessState();
-
-            if (state == 1) { ///Loading
-                loadingWaitingScreen->setVisible(true);
-                loadingWaitingScreen->startAnimation();
-            } else if (state == 2) { ///Success
-                loadingWaitingScreen->setVisible(false);
-                loadingWaitingScreen->stopAnimation();
-            } else { ///Fail
-                AlertWindow::showMessageBoxAsync (AlertWindow::WarningIcon, TRANS("Error while loading"), TRANS("Couldn't read from the specified file!"));
-
-            }
-        }
+        ///Processor and name from the same chain, the worker may have added effects since it was built
+        auto* chain = audioProcessor.getLatestChain();
+        AudioProcessor* first = chain != nullptr ? chain->getEffectProcessor(0) : nullptr;
         
-        if (audioProcessor.UIupdate_EffectBlocks) {
-            audioProcessor.UIupdate_EffectBlocks = false;
-            
-            if (audioProcessor.getNumberOfEffect() == 0) {
-                showEffects = false;
-                chorusBlock = nullptr;
-            } else {
-                AudioProcessor* first = audioProcessor.getaudioProcessFromIndex(0);
-                if (first != nullptr) {
-                    chorusBlock.reset(new ChorusUiBlock(first, nameFromEffectEnum(audioProcessor.getEffectChain()[0])));
-                    addAndMakeVisible(*chorusBlock);
-                    showEffects = true;
-                }
-            }
-            resized();
+        ///Only the chorus has a block so far
+        if (dynamic_cast<ChorusProcessor*>(first) == nullptr) {
+            showEffects = false;
+            chorusBlock = nullptr;
+        } else {
+            chorusBlock.reset(new ChorusUiBlock(first, nameFromEffectEnum(chain->getEffects()[0])));
+            addAndMakeVisible(*chorusBlock);
+            showEffects = true;
         }
+        resized();
+    }
+    
+    //===================================================
+    // MARK: - Analysis Listener
+    //===================================================
+    
+    void analysisProgressed(const AnalysisJob&, double progress) override
+    {
+        loadingWaitingScreen->setProgress(progress);
+    }
+    
+    void analysisFinished(const AnalysisJob& job) override
+    {
+        if (job.getStatus() == AnalysisJobStatus::Failed)
+            AlertWindow::showMessageBoxAsync (AlertWindow::WarningIcon, TRANS("Error while loading"),
+                                              job.errorMessage.isNotEmpty() ? job.errorMessage : TRANS("Couldn't read from the specified file!"));
+        
+        updateProcessingState();
+        
+        if (timingOverlay->isVisible())
+            timingOverlay->setRecords(audioProcessor.getAnalysisTimings());
+    }
+    
+    void modelStateChanged() override
+    {
+        updateModelStateLabel();
+    }
+    
+    void liveResultChanged() override
+    {
+        updateLiveLabel();
     }
     
     //===================================================
@@ -106,11 +116,7 @@ public:
     
     void fileBeingDropInZone(const StringArray& files) override
     {
-        if (files.size() != 1) {
-            //AlertWindow::showMessageBoxAsync(AlertWindow::WarningIcon, "Error", "Only one audio file should be drop", "OK", this, ModalCallbackFunction::create ([] () {}));
-            return;
-        }
-        audioProcessor.setTargetToProcess(File(files[0]));
+        analyseFiles(files);
     }
     
     void clickDownOnZone(const MouseEvent &event) override
@@ -118,6 +124,14 @@ public:
         browseFileButton->mouseDown(event);
     }
     
+    void updateModelStateLabel();
+    void updateLiveLabel();
+    void updateProcessingState();
+    void exportTimings();
+    
+    ///A new batch pre-empts what is left of the previous one, its files are then analysed one after the other
+    void analyseFiles(const StringArray& files);
+    
     void buttonClicked (juce::Button* buttonThatWasClicked) override;
     void selectFileButtonDidSelectNewFiles(SelectFileButton* button, StringArray files, Array<URL> urls) override;
 
@@ -137,6 +151,13 @@ private:
 
     std::unique_ptr<ImageButton> cancelButton;
     
+    std::unique_ptr<juce::ToggleButton> liveButton;
+    std::unique_ptr<juce::Label> liveLabel;
+    
+    std::unique_ptr<juce::ToggleButton> timingsButton;
+    std::unique_ptr<TimingOverlay> timingOverlay;
+    std::unique_ptr<FileChooser> timingsChooser;
+    
     std::unique_ptr<dropFileZone> dropZone;
     std::unique_ptr<LoadingWaitingScreen> loadingWaitingScreen;
 
@@ -19,22 +19,23 @@ AutoEffectsAudioProcessor::AutoEffectsAudioProcessor()
                       #endif
                        .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
                      #endif
-                       ), processGraph(new juce::AudioProcessorGraph()),
+                       ),
 #endif
                         Thread("AutoEffectThread")
 {
-    const char* data = BinaryData::classifier_pt;
-    const int length = BinaryData::classifier_ptSize;
-
-    std::istringstream is(std::string(data, length));
-    classifier = torch::jit::load(is);
+    instantiationTime = Time::getMillisecondCounterHiRes();
+    weakThis = this;
     
+    ///The model is loaded by the thread itself so hosts don't wait for it on the message thread
     startThread();
 }
 
 AutoEffectsAudioProcessor::~AutoEffectsAudioProcessor()
 {
-    stopThread(1000);
+    ///An analysis in progress stops at its next check, the model load can't be interrupted so give it time to finish
+    cancelAllAnalyses();
+    stopThread(10000);
+    cancelPendingUpdate();
 }
 
 //==============================================================================
@@ -72,7 +73,7 @@ bool AutoEffectsAudioProcessor::isMidiEffect() const
 
 double AutoEffectsAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    return tailLengthSeconds.load();
 }
 
 int AutoEffectsAudioProcessor::getNumPrograms()
@@ -104,20 +105,20 @@ void AutoEffectsAudioProcessor::prepareToPlay (double sampleRate, int samplesPer
 {
     // Use this method as the place to do any pre-playback
     // initialisation that you need..
-    processGraph->setPlayConfigDetails (getMainBusNumInputChannels(),
-                                         getMainBusNumOutputChannels(),
-                                         sampleRate, samplesPerBlock);
-
-    processGraph->prepareToPlay (sampleRate, samplesPerBlock);
-
-    initialiseGraph();
+    callbackMonitor.prepare (sampleRate);
+    liveCapture.prepare (sampleRate, getLiveAnalysisSettings().maxCaptureLatencySeconds);
+
+    ///The live chain was prepared for the previous settings, blocks stay dry until the new one is published
+    if (MessageManager::getInstance()->isThisTheMessageThread())
+        rebuildChain();
+    else
+        triggerAsyncUpdate();
 }
 
 void AutoEffectsAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
-    processGraph->releaseResources();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -149,6 +150,8 @@ bool AutoEffectsAudioProcessor::isBusesLayoutSupported (const BusesLayout& layou
 void AutoEffectsAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    callbackMonitor.blockStarted();
+    
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
@@ -161,10 +164,14 @@ void AutoEffectsAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
     
-    updateGraph();
-
-
-    processGraph->processBlock(buffer, midiMessages);
+    ///Live mode classifies what comes in, before our own effects
+    liveCapture.pushBlock (buffer, totalNumInputChannels);
+    
+    ///Latest chain published by the message thread, taken without waiting
+    auto* chain = chains.getChainForAudioThread();
+    
+    if (chain != nullptr && chain->canProcess(buffer.getNumSamples(), getSampleRate()))
+        chain->process(buffer, midiMessages);
     // This is the place where you'd normally do the guts of your plugin's
     // audio processing...
     // Make sure to reset the state if your inner loop is processing
@@ -177,6 +184,8 @@ void AutoEffectsAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
 
         // ..do something to the data...
     }
+    
+    callbackMonitor.blockFinished (buffer.getNumSamples(), analysisRunning.load());
 }
 
 //==============================================================================
@@ -204,97 +213,369 @@ void AutoEffectsAudioProcessor::setStateInformation (const void* data, int sizeI
     // whose contents will have been created by the getStateInformation() call.
 }
 
-void AutoEffectsAudioProcessor::processAudioFile()
+void AutoEffectsAudioProcessor::rebuildChain()
 {
-    AudioFormatManager formatManager;
-    formatManager.registerBasicFormats();
-        
-    // Check that the file exists and that we can have a reader
-    if (!targetFile.existsAsFile())
-    {
-        Logger::writeToLog("Could not find track file " + targetFile.getFileName());
-        processState = processState::Fail;
-        UIupdate_processing = true;
+    ///Not prepared yet, prepareToPlay builds the first chain
+    if (getSampleRate() <= 0.0 || getBlockSize() <= 0)
         return;
+    
+    auto numChannels = jmax(getMainBusNumInputChannels(), getMainBusNumOutputChannels());
+    
+    auto chain = std::make_unique<ProcessingChain>(getEffectChain(), numChannels, getSampleRate(), getBlockSize(),
+                                                   ProcessingChain::Engine::flat, oversamplingFactor);
+    
+    auto tail = chain->getTailLengthSeconds();
+    auto latency = chain->getLatencySamples();
+    chains.publish(std::move(chain));
+    
+    ///Tells the host if it changed
+    setLatencySamples(latency);
+    
+    ///Hosts ask again once told something changed, so they keep rendering until a new reverb or delay has faded
+    if (tailLengthSeconds.exchange(tail) != tail)
+        updateHostDisplay();
+    
+    if (auto* editor = dynamic_cast<AutoEffectsAudioProcessorEditor*>(getActiveEditor()))
+        editor->updateEffectBlocks();
+}
+
+void AutoEffectsAudioProcessor::loadClassifier()
+{
+    auto variant = requestedVariant.load();
+    loadedVariantRequest = variant;
+    
+    if (variant == ModelVariant::Int8 && !SharedClassifier::isVariantAvailable(variant)) {
+        Logger::writeToLog("No int8 classifier embedded or in the model folder, using fp32");
+        variant = ModelVariant::Float32;
     }
-        
-    std::unique_ptr<AudioFormatReader> reader(formatManager.createReaderFor(targetFile));
-    if (!reader)
-    {
-        Logger::writeToLog("Could not load track from file " + targetFile.getFileName());
-        processState = processState::Fail;
-        UIupdate_processing = true;
-        return;
+    
+    ///Switching model at runtime, files dropped meanwhile wait in the queue
+    if (classifier != nullptr && (classifier->getVariant() != variant || classifier->isOutdated())) {
+        classifierState = modelState::Loading;
+        postModelStateChange();
     }
+    
+    try {
+        auto startTime = Time::getMillisecondCounterHiRes();
+        auto memoryBefore = getResidentMemoryBytes();
+        bool loadedHere = false;
         
-    // Basic properties of the audio buffer
-    int numSamples    = (int)reader->lengthInSamples;
-    double sampleRate = reader->sampleRate;
-    unsigned int numChannels   = reader->numChannels;
-    int targetLength  = 44100;
+        ///Every instance of the process shares the same weights, only the first one pays for the load
+        SharedClassifier::Ptr newClassifier;
         
-    AudioSampleBuffer inputBuffer(numChannels,numSamples);
-    inputBuffer.clear();
+        try {
+            newClassifier = SharedClassifier::acquire(variant, getAnalysisSettings().windowLength, &loadedHere);
+        } catch (const std::exception& e) {
+            if (variant == ModelVariant::Float32)
+                throw;
+            
+            Logger::writeToLog(String("Could not load int8 classifier, using fp32: ") + e.what());
+            variant = ModelVariant::Float32;
+            newClassifier = SharedClassifier::acquire(variant, getAnalysisSettings().windowLength, &loadedHere);
+        }
         
-    reader->read(&inputBuffer, 0, numSamples, 0, true, true);
+        auto readyTime = Time::getMillisecondCounterHiRes();
+        modelLoadTimings.loadMs = loadedHere ? newClassifier->getLoadMs() : 0.0;
+        modelLoadTimings.warmUpMs = loadedHere ? newClassifier->getWarmUpMs() : 0.0;
+        modelLoadTimings.acquireMs = readyTime - startTime;
+        modelLoadTimings.readyAfterMs = readyTime - instantiationTime;
+        modelLoadTimings.residentMemoryDelta = getResidentMemoryBytes() - memoryBefore;
         
-    std::cout << "DONE" << std::endl;
+        ///The previous model is freed here if no other instance uses it
+        classifier = std::move(newClassifier);
+        activeVariant = variant;
+        classifierState = modelState::Ready;
         
-    // 1b) Resample
+        auto source = classifier->getSourceFile() != File() ? classifier->getSourceFile().getFullPathName() : String("embedded");
         
-    std::cout << "Resampling from " << sampleRate << " to " << modelSampleRate  << std::endl;
+        Logger::writeToLog("Classifier (" + SharedClassifier::getVariantName(variant) + ", " + source + ", "
+                           + classifier->getBackendName() + " backend) ready after "
+                           + String(modelLoadTimings.readyAfterMs, 1) + " ms (load "
+                           + String(modelLoadTimings.loadMs, 1) + " ms, warm-up " + String(modelLoadTimings.warmUpMs, 1)
+                           + " ms), resident memory +" + String(modelLoadTimings.residentMemoryDelta / (1024.0 * 1024.0), 1)
+                           + " MB for this instance" + (loadedHere ? "" : " (shared model)"));
+    } catch (const std::exception& e) {
+        modelLoadTimings.readyAfterMs = Time::getMillisecondCounterHiRes() - instantiationTime;
+        classifierState = modelState::Unavailable;
         
-    double ratio =  sampleRate / modelSampleRate;
-    int newNumSamples = (int)(((double)numSamples) / ratio);
+        Logger::writeToLog(String("Could not load classifier: ") + e.what());
+    }
+    
+    postModelStateChange();
+}
+
+void AutoEffectsAudioProcessor::applyInferenceThreadSettings()
+{
+    auto settings = getInferenceThreadSettings();
+    
+    setPriority(settings.workerPriority);
+    
+    ///A mask of 0 gives every core back to the thread
+    auto allCores = (uint32) ((1ull << jmin(32, SystemStats::getNumCpus())) - 1);
+    Thread::setCurrentThreadAffinityMask(settings.affinityMask != 0 ? settings.affinityMask : allCores);
+    
+    if (classifier != nullptr)
+        classifier->setNumInferenceThreads(settings.getNumIntraOpThreads());
+}
+
+AnalysisJob::Ptr AutoEffectsAudioProcessor::submitAnalysisJob(const File& audioFile, AnalysisJob::CompletionCallback onComplete,
+                                                             bool preemptOlderJobs)
+{
+    return enqueueJob(new AnalysisJob(++nextJobId, audioFile, std::move(onComplete)), preemptOlderJobs);
+}
+
+AnalysisJob::Ptr AutoEffectsAudioProcessor::analyseAsync(const File& audioFile, AnalysisCallbacks callbacks, bool preemptOlderJobs)
+{
+    AnalysisJob::Ptr job = new AnalysisJob(++nextJobId, audioFile, nullptr);
+    job->callbacks = std::move(callbacks);
+    
+    return enqueueJob(job, preemptOlderJobs);
+}
+
+AnalysisJob::Ptr AutoEffectsAudioProcessor::enqueueJob(AnalysisJob::Ptr job, bool preemptOlderJobs)
+{
+    AnalysisJob::Ptr handle = job;
+    
+    if (preemptOlderJobs)
+        cancelJobsUpTo(job->id - 1);
+    
+    if (!jobQueue.push(job)) {
+        Logger::writeToLog("Analysis queue is full, dropping " + handle->file.getFileName());
+        return nullptr;
+    }
+    
+    processState = processState::Process;
+    
+    ///Wake up 'run' fonction in Thread
+    notify();
+    
+    return handle;
+}
+
+void AutoEffectsAudioProcessor::cancelJobsUpTo(int lastJobId)
+{
+    ///Queued jobs can't be removed from the lock free queue, the worker skips them when it pops them
+    auto previous = cancelledUpToJobId.load();
+    while (previous < lastJobId && !cancelledUpToJobId.compare_exchange_weak(previous, lastJobId)) {}
+    
+    const ScopedLock sl (currentJobLock);
+    if (currentJob != nullptr && currentJob->id <= lastJobId)
+        currentJob->cancel();
+}
+
+void AutoEffectsAudioProcessor::runJob(AnalysisJob& job)
+{
+    job.status = AnalysisJobStatus::Running;
+    
+    auto& timings = job.timings;
+    bool succeeded = false;
+    
+    ///Jobs pre-empted while they were waiting in the queue are not even opened
+    if (!job.isCancelled()) {
+        applyInferenceThreadSettings();
         
-    AudioSampleBuffer resampledInputBuffer;
+        timings.jobId = job.id;
+        timings.fileName = job.file.getFileName();
+        timings.modelVariant = SharedClassifier::getVariantName(activeVariant);
+        timings.startTimeMs = Time::currentTimeMillis();
         
-    if (newNumSamples > targetLength)
-        newNumSamples = targetLength;
+        analysisRunning = true;
+        auto startTime = Time::getMillisecondCounterHiRes();
+        auto allocationsBefore = AllocationCounter::getThreadAllocationCount();
+        succeeded = processAudioFile(job);
+        job.processingSeconds = (Time::getMillisecondCounterHiRes() - startTime) * 0.001;
+        if (AllocationCounter::isEnabled())
+            job.numAllocations = AllocationCounter::getThreadAllocationCount() - allocationsBefore;
+        analysisRunning = false;
+    }
+    
+    ///Adding result in array of Effects enum, the message thread builds the new chain. Checked under the lock
+    ///resetPlugin takes after cancelling, so a result can't come back once the chain was cleared
+    if (succeeded) {
+        const ScopedLock sl (chainLock);
         
-    resampledInputBuffer.setSize(numChannels, targetLength);
-    resampledInputBuffer.clear();
+        if (!job.isCancelled()) {
+            effectsChain.add(job.result.effect);
+            triggerAsyncUpdate();
+        }
+    }
+    
+    auto cancelled = job.isCancelled();
+    job.status = cancelled ? AnalysisJobStatus::Cancelled
+               : succeeded ? AnalysisJobStatus::Succeeded
+                           : AnalysisJobStatus::Failed;
+    
+    ///Keep the loading screen while other files are waiting, unless this one failed
+    if (!succeeded && !cancelled)
+        processState = processState::Fail;
+    else if (jobQueue.getNumPending() > 0)
+        processState = processState::Process;
+    else
+        processState = processState::Success;
+    
+    if (!cancelled) {
+        timings.succeeded = succeeded;
+        timings.numWindows = job.result.numWindows;
+        timings.numAllocations = job.numAllocations;
+        timings.totalMs = job.processingSeconds * 1000.0;
         
-    ScopedPointer<LagrangeInterpolator> resampler = new LagrangeInterpolator();
+        numProcessedJobs++;
+        totalProcessingSeconds = totalProcessingSeconds.load() + job.processingSeconds;
         
-    const float *inputPtr = inputBuffer.getReadPointer(0);
-    float *outputPtr      = resampledInputBuffer.getWritePointer(0);
+        const ScopedLock sl (timingsLock);
+        timings.publishedAtMs = Time::getMillisecondCounterHiRes();
+        timingHistory.push_back(timings);
         
-    resampler->reset();
-    resampler->process(ratio, inputPtr, outputPtr, newNumSamples);
+        while (timingHistory.size() > maxTimingRecords)
+            timingHistory.pop_front();
+    }
+    
+    postCompletion(job);
+    
+    DBG((cancelled ? "Cancelled " : "Analysed ") << job.file.getFileName() << " after " << job.processingSeconds << "s, "
+        << getAnalysisThroughput() << " files/s"
+        << (job.numAllocations >= 0 ? ", " + String(job.numAllocations) + " allocations" : String()));
+    
+    if (job.onComplete)
+        job.onComplete(job);
+}
+
+void AutoEffectsAudioProcessor::postProgress(AnalysisJob& job, double progress)
+{
+    job.progress = progress;
+    
+    ///One message at a time per job, it reads the latest progress when it runs
+    if (job.progressPending.exchange(true))
+        return;
+    
+    MessageManager::callAsync([handle = AnalysisJob::Ptr(&job), processor = weakThis] {
+        handle->progressPending = false;
+        auto progress = handle->progress.load();
         
-    std::cout << "DONE" << std::endl;;
-            
-        //----------------------
-        // 2) Normalize input file
+        if (handle->callbacks.onProgress)
+            handle->callbacks.onProgress(*handle, progress);
         
-        //float mag = resampledInputBuffer.getMagnitude(0, newNumSamples);
-        //resampledInputBuffer.applyGain(0, newNumSamples, 1./mag);
+        if (auto* p = processor.get())
+            p->analysisListeners.call([&] (AnalysisListener& l) { l.analysisProgressed(*handle, progress); });
+    });
+}
+
+void AutoEffectsAudioProcessor::postCompletion(AnalysisJob& job)
+{
+    MessageManager::callAsync([handle = AnalysisJob::Ptr(&job), processor = weakThis] {
+        auto& finishedJob = *handle;
+        auto& callbacks = finishedJob.callbacks;
         
-    const float *bufferPtr = resampledInputBuffer.getReadPointer(0);
+        if (finishedJob.getStatus() == AnalysisJobStatus::Succeeded) {
+            if (callbacks.onComplete)
+                callbacks.onComplete(finishedJob);
+        } else if (callbacks.onError) {
+            callbacks.onError(finishedJob, finishedJob.getStatus() == AnalysisJobStatus::Cancelled ? String("Analysis cancelled")
+                                                                                                    : finishedJob.errorMessage);
+        }
         
-    Array<float> bufferData = Array<float>(bufferPtr, targetLength);
+        if (auto* p = processor.get()) {
+            p->analysisListeners.call([&] (AnalysisListener& l) { l.analysisFinished(finishedJob); });
+            p->recordUINotification(finishedJob.id, finishedJob.timings.publishedAtMs);
+        }
+    });
+}
+
+void AutoEffectsAudioProcessor::postModelStateChange()
+{
+    MessageManager::callAsync([processor = weakThis] {
+        if (auto* p = processor.get())
+            p->analysisListeners.call([] (AnalysisListener& l) { l.modelStateChanged(); });
+    });
+}
+
+void AutoEffectsAudioProcessor::postLiveResult()
+{
+    ///A hop is shorter than a busy message thread can be, don't queue one message per window
+    if (liveResultPending.exchange(true))
+        return;
+    
+    MessageManager::callAsync([processor = weakThis] {
+        if (auto* p = processor.get()) {
+            p->liveResultPending = false;
+            p->analysisListeners.call([] (AnalysisListener& l) { l.liveResultChanged(); });
+        }
+    });
+}
+
+void AutoEffectsAudioProcessor::recordUINotification(int jobId, double publishedAtMs)
+{
+    if (publishedAtMs <= 0.0)
+        return;
+    
+    auto delayMs = Time::getMillisecondCounterHiRes() - publishedAtMs;
+    const ScopedLock sl (timingsLock);
+    
+    ///Usually the latest record, unless several jobs finished before the message thread got to them
+    for (auto record = timingHistory.rbegin(); record != timingHistory.rend(); ++record) {
+        if (record->jobId == jobId) {
+            (*record)[AnalysisTimingRecord::UINotification] = delayMs;
+            break;
+        }
+    }
+}
+
+void AutoEffectsAudioProcessor::runLiveAnalysis(bool justStarted, bool resumedAfterJob)
+{
+    auto captureRate = liveCapture.getSampleRate();
+    if (captureRate <= 0.0)
+        return;
+    
+    if (justStarted || liveSettingsChanged.exchange(false) || !liveClassifier.isPreparedFor(captureRate)) {
+        ///Audio captured before a restart is too old to describe what is playing now
+        if (justStarted)
+            numLiveWindows = 0;
+        liveClassifier.reset(captureRate, modelSampleRate, getLiveAnalysisSettings());
+        liveClassifier.restart(liveCapture);
+    } else if (resumedAfterJob) {
+        ///What was captured while the job ran describes the past, not what is playing now
+        liveClassifier.restart(liveCapture);
+    }
+    
+    try {
+        AnalysisResult result;
         
-    torch::Tensor input = torch::from_blob(bufferData.data(), {1,targetLength});
+        analysisRunning = true;
+        bool classified = liveClassifier.update(liveCapture, *classifier, result);
+        analysisRunning = false;
         
+        if (!classified)
+            return;
         
-    std::vector<torch::jit::IValue> inputs;
-    inputs.push_back(input);
+        liveEffect = (int) result.effect;
+        liveScore = result.classScores.empty() ? 0.f : result.classScores[(size_t) result.effect];
+        numLiveWindows++;
+        postLiveResult();
+    } catch (const std::exception& e) {
+        analysisRunning = false;
+        Logger::writeToLog(String("Live classification failed: ") + e.what());
+    }
+}
 
-        
-    auto output = classifier.forward(inputs).toTensor();
-        
-    ///Adding result in array of Effects enum and update graph
+bool AutoEffectsAudioProcessor::processAudioFile(AnalysisJob& job)
+{
+    if (!isModelReady())
+    {
+        job.errorMessage = "Classifier unavailable, can't process " + job.file.getFileName();
+        Logger::writeToLog(job.errorMessage);
+        return false;
+    }
     
-    int result = output.item<int>();
-    DBG(result);
+    fileAnalyser.setCacheSettings(getAnalysisCacheSettings());
+    fileAnalyser.setProgressCallback([this, &job] (double progress) { postProgress(job, progress); });
     
+    auto succeeded = fileAnalyser.analyse(job.file, *classifier, getAnalysisSettings(), job.result, &job.timings, &job.cancellation);
+    fileAnalyser.setProgressCallback(nullptr);
     
-    effectsChain.add(static_cast<EffectEnum>(result));
-    NeedToUpdateGraph = true;
+    if (!succeeded)
+        job.errorMessage = fileAnalyser.getLastError();
     
-    processState = processState::Success;
-    UIupdate_processing = true;
+    return succeeded;
 }
 
 //==============================================================================
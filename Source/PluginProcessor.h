@@ -8,22 +8,27 @@
 
 #pragma once
 
-#include "EffectProcessors.h"
+#include "ProcessingChain.h"
+#include "Analysis/AnalysisJobQueue.h"
+#include "Analysis/WindowedClassifier.h"
+#include "Analysis/ResidentMemory.h"
+#include "Analysis/AudioCallbackMonitor.h"
+#include "Analysis/AnalysisResultCache.h"
+#include "Analysis/FileAnalyser.h"
+#include "Analysis/LiveClassifier.h"
+#include "Analysis/AllocationCounter.h"
 
 #include <BinaryData.h>
-#include <torch/script.h>
+#include <deque>
 
 //==============================================================================
 /**
 */
 
-class AutoEffectsAudioProcessor  : public juce::AudioProcessor, public Thread
+class AutoEffectsAudioProcessor  : public juce::AudioProcessor, public Thread, private AsyncUpdater
 {
 public:
     
-    //==============================================================================
-    using AudioGraphIOProcessor = juce::AudioProcessorGraph::AudioGraphIOProcessor;
-    using Node = juce::AudioProcessorGraph::Node;
     //==============================================================================
     AutoEffectsAudioProcessor();
     ~AutoEffectsAudioProcessor() override;
@@ -69,176 +74,408 @@ public:
     
     processState getProcessState() { return processState; }
     
-    void setTargetToProcess(const File audioFile)
+    enum modelState {
+        Loading = 0,
+        Ready,
+        Unavailable
+    };
+    
+    ///The classifier is loaded and warmed up by the worker thread, jobs wait in the queue meanwhile
+    modelState getModelState() const { return classifierState; }
+    bool isModelReady() const { return classifierState == modelState::Ready; }
+    
+    struct ModelLoadTimings {
+        double loadMs = 0.0;        ///Load of the embedded or external model by its backend, 0 if another instance already loaded it
+        double warmUpMs = 0.0;      ///First dummy forward pass, 0 if another instance already did it
+        double acquireMs = 0.0;     ///Time spent getting the shared model, including waiting for another instance
+        double readyAfterMs = 0.0;  ///From the processor constructor to the Ready state
+        int64 residentMemoryDelta = 0; ///Process resident memory added while this instance got its model
+    };
+    
+    ///Only meaningful once getModelState() is not Loading anymore
+    ModelLoadTimings getModelLoadTimings() const { return modelLoadTimings; }
+    
+    ///Model used by the next analyses, the worker switches before its next job. Int8 falls back to fp32 if it isn't embedded
+    void setModelVariant(ModelVariant variant)
+    {
+        requestedVariant = variant;
+        notify();
+    }
+    
+    ///Variant actually loaded, may differ from the requested one after a fallback
+    ModelVariant getModelVariant() const { return activeVariant; }
+    
+    /** Model files in SharedClassifier::getModelDirectory() are checked before every analysis, this
+        checks them now. A changed file is loaded by the worker while the running analysis finishes
+        on the previous model, and the embedded model is used if the new file is rejected.
+    */
+    void checkForModelUpdates() { notify(); }
+    
+    /** Queue a file for classification, the worker thread is woken up straight away.
+        Returns nullptr if the queue is full. The callback is called on the worker thread.
+        With preemptOlderJobs, every job submitted before this one is cancelled, the running one included,
+        so the worker moves on to this file after at most one chunk read or one forward batch.
+    */
+    AnalysisJob::Ptr submitAnalysisJob(const File& audioFile, AnalysisJob::CompletionCallback onComplete = nullptr,
+                                       bool preemptOlderJobs = false);
+    
+    /** Same as submitAnalysisJob, but every callback is delivered on the message thread, even if the
+        processor is deleted in the meantime. The returned job can be used to cancel the analysis.
+        Returns nullptr if the queue is full, onError is then never called.
+    */
+    AnalysisJob::Ptr analyseAsync(const File& audioFile, AnalysisCallbacks callbacks, bool preemptOlderJobs = false);
+    
+    /** Told about every analysis on the message thread, whoever submitted it. */
+    struct AnalysisListener
     {
-        processState = processState::Process;
-        UIupdate_processing = true;
+        virtual ~AnalysisListener() = default;
         
-        targetFile = audioFile;
+        virtual void analysisProgressed(const AnalysisJob&, double /*progress*/) {}
         
-        ///Set flag for 'run' fonction in Thread
-        hasTargetToProcess = true;
+        ///Succeeded, failed or cancelled, see the job status
+        virtual void analysisFinished(const AnalysisJob&) = 0;
+        
+        ///The classifier started or finished loading, see getModelState()
+        virtual void modelStateChanged() {}
+        
+        ///A new live window was classified, see getLiveAnalysisState()
+        virtual void liveResultChanged() {}
+    };
+    
+    ///Message thread only
+    void addAnalysisListener(AnalysisListener* listener)    { analysisListeners.add(listener); }
+    void removeAnalysisListener(AnalysisListener* listener) { analysisListeners.remove(listener); }
+    
+    ///Returns the id of the queued job, or -1 if it couldn't be queued
+    int setTargetToProcess(const File audioFile, bool preemptOlderJobs = false)
+    {
+        auto job = submitAnalysisJob(audioFile, nullptr, preemptOlderJobs);
+        return job != nullptr ? job->id : -1;
     }
     
-    void processAudioFile();
+    ///Cancels the running analysis and every queued one, their results are never added to the chain
+    void cancelAllAnalyses() { cancelJobsUpTo(nextJobId.load()); }
     
-    Array<EffectEnum> &getEffectChain() { return effectsChain; }
-
-    int getNumberOfEffect() { return effectsChain.size(); }
+    int getNumPendingJobs() const { return jobQueue.getNumPending(); }
     
-    AudioProcessor* getaudioProcessFromIndex(int i) {
-        if (i < 0 || i > nodes.size())
-            return nullptr;
-        return nodes[i]->getProcessor();
+    ///Number of files classified per second of worker time since the plugin was created
+    double getAnalysisThroughput() const
+    {
+        auto seconds = totalProcessingSeconds.load();
+        return seconds > 0.0 ? (double) numProcessedJobs.load() / seconds : 0.0;
     }
     
-    void resetPlugin() {
-        effectsChain.clear();
-        
-        for (auto node : nodes)
-            processGraph->removeNode(node.get());
-        nodes.clear();
-        
-        NeedToUpdateGraph = true;
-        UIupdate_EffectBlocks = true;
+    bool processAudioFile(AnalysisJob& job);
+    
+    ///Settings are copied by the worker at the start of each job
+    void setAnalysisSettings(const AnalysisSettings& newSettings)
+    {
+        const ScopedLock sl (settingsLock);
+        analysisSettings = newSettings;
     }
     
-    void initialiseGraph() {
-        processGraph->clear();
-
-        audioInputNode  = processGraph->addNode (std::make_unique<AudioGraphIOProcessor> (AudioGraphIOProcessor::audioInputNode));
-        audioOutputNode = processGraph->addNode (std::make_unique<AudioGraphIOProcessor> (AudioGraphIOProcessor::audioOutputNode));
-        midiInputNode   = processGraph->addNode (std::make_unique<AudioGraphIOProcessor> (AudioGraphIOProcessor::midiInputNode));
-        midiOutputNode  = processGraph->addNode (std::make_unique<AudioGraphIOProcessor> (AudioGraphIOProcessor::midiOutputNode));
-
-        connectAudioNodes();
-        connectMidiNodes();
+    AnalysisSettings getAnalysisSettings() const
+    {
+        const ScopedLock sl (settingsLock);
+        return analysisSettings;
     }
     
-    void connectAudioNodes()
+    ///Applied by the worker at the start of each job
+    void setInferenceThreadSettings(const InferenceThreadSettings& newSettings)
     {
-        for (int channel = 0; channel < 2; ++channel)
-            processGraph->addConnection ({ { audioInputNode->nodeID,  channel },
-                                            { audioOutputNode->nodeID, channel } });
+        const ScopedLock sl (settingsLock);
+        threadSettings = newSettings;
     }
-
-    void connectMidiNodes()
+    
+    InferenceThreadSettings getInferenceThreadSettings() const
     {
-        processGraph->addConnection ({ { midiInputNode->nodeID,  juce::AudioProcessorGraph::midiChannelIndex },
-                                        { midiOutputNode->nodeID, juce::AudioProcessorGraph::midiChannelIndex } });
+        const ScopedLock sl (settingsLock);
+        return threadSettings;
     }
     
-    void updateGraph()
+    ///Limits of the on-disk result cache shared with the other instances
+    void setAnalysisCacheSettings(const AnalysisCacheSettings& newSettings)
     {
-        if (!NeedToUpdateGraph)
-            return;
-        
-        NeedToUpdateGraph = false;
-        
-        ///Clear current graph to rebuilt it complely
-        for (auto node : nodes)
-            processGraph->removeNode(node.get());
-        nodes.clear();
-        
-        ///adding in array from a dataset
-        for (int i = 0 ; i < effectsChain.size(); i++) {
-            nodes.add(processGraph->addNode (std::make_unique<ChorusProcessor>()));
+        const ScopedLock sl (settingsLock);
+        cacheSettings = newSettings;
+    }
+    
+    AnalysisCacheSettings getAnalysisCacheSettings() const
+    {
+        const ScopedLock sl (settingsLock);
+        return cacheSettings;
+    }
+    
+    ///Live mode classifies the plugin input every hop, on the same worker as the file jobs
+    void setLiveAnalysisSettings(const LiveAnalysisSettings& newSettings)
+    {
+        {
+            const ScopedLock sl (settingsLock);
+            liveSettings = newSettings;
         }
         
-        ///Remove all connections
-        for (auto connection : processGraph->getConnections())
-            processGraph->removeConnection (connection);
-        
-        for (auto node : nodes)
-            node->getProcessor()->setPlayConfigDetails (getMainBusNumInputChannels(),
-                                                        getMainBusNumOutputChannels(),
-                                                        getSampleRate(), getBlockSize());
+        liveSettingsChanged = true;
+        liveCapture.setEnabled(newSettings.enabled);
+        notify();
+    }
+    
+    LiveAnalysisSettings getLiveAnalysisSettings() const
+    {
+        const ScopedLock sl (settingsLock);
+        return liveSettings;
+    }
+    
+    struct LiveAnalysisState {
+        EffectEnum effect = EffectEnum::Dry;
+        float score = 0.f;              ///Score of 'effect' for the latest window
+        int numWindows = 0;             ///Windows classified since live mode was turned on
+        int64 numDroppedSamples = 0;    ///Input dropped because the worker was busy, since prepareToPlay
+    };
+    
+    ///Lock free, safe to poll from the message thread
+    LiveAnalysisState getLiveAnalysisState() const
+    {
+        LiveAnalysisState state;
+        state.effect = static_cast<EffectEnum>(liveEffect.load());
+        state.score = liveScore.load();
+        state.numWindows = numLiveWindows.load();
+        state.numDroppedSamples = liveCapture.getNumDroppedSamples();
+        return state;
+    }
+    
+    ///Stage timings of the latest analyses, oldest first, at most maxTimingRecords of them
+    std::vector<AnalysisTimingRecord> getAnalysisTimings() const
+    {
+        const ScopedLock sl (timingsLock);
+        return { timingHistory.begin(), timingHistory.end() };
+    }
+    
+    void clearAnalysisTimings()
+    {
+        const ScopedLock sl (timingsLock);
+        timingHistory.clear();
+    }
+    
+    ///Writes JSON if the file ends in .json, CSV otherwise
+    bool exportAnalysisTimings(const File& destination) const
+    {
+        auto records = getAnalysisTimings();
+        return destination.replaceWithText(destination.hasFileExtension("json") ? AnalysisTimingRecord::toJSON(records)
+                                                                               : AnalysisTimingRecord::toCSV(records));
+    }
+    
+    ///Measurement mode counting audio callback overruns, split by whether an analysis was running
+    void setAudioCallbackMonitoring(bool shouldMonitor) { callbackMonitor.setEnabled(shouldMonitor); }
+    AudioCallbackMonitor::Stats getAudioCallbackStats() const { return callbackMonitor.getStats(); }
+    void resetAudioCallbackStats() { callbackMonitor.reset(); }
+    
+    ///Copy, the worker may add to the chain at any time
+    Array<EffectEnum> getEffectChain() const
+    {
+        const ScopedLock sl (chainLock);
+        return effectsChain;
+    }
+
+    int getNumberOfEffect() const
+    {
+        const ScopedLock sl (chainLock);
+        return effectsChain.size();
+    }
+    
+    ///Message thread only, valid until the editor was told about the next chain. nullptr before prepareToPlay
+    const ProcessingChain* getLatestChain() const { return chains.getLatest(); }
+    
+    ///Message thread only, the processor stays valid until the editor was told about the next chain
+    AudioProcessor* getaudioProcessFromIndex(int i) {
+        auto* chain = chains.getLatest();
+        return chain != nullptr ? chain->getEffectProcessor(i) : nullptr;
+    }
+    
+    /** Oversampling of the Distortion and Overdrive effects, 1 to 16. Higher factors alias less
+        but cost more CPU and latency, which is reported to the host. Message thread only, the
+        chain playing is never touched: a new one is built with the factor and handed over.
+    */
+    void setOversamplingFactor(int factor) {
+        factor = jlimit(1, WaveshaperProcessor::maximumOversamplingFactor, factor);
         
-        ///If no effect to chain, connect input to output
-        if (nodes.isEmpty()) {
-            connectAudioNodes();
-        } else {
+        if (factor == oversamplingFactor)
+            return;
         
-        ///Connecting nodes beetween them in order of the array
-        for (int i = 0; i < nodes.size() - 1; ++i) {
-            for (int channel = 0; channel < 2; ++channel)
-                processGraph->addConnection ({ { nodes[i]->nodeID, channel },
-                                                { nodes[i + 1]->nodeID, channel } });
-         }
-
-        ///Connecting input to first node and last node to output
-         for (int channel = 0; channel < 2; ++channel) {
-             processGraph->addConnection ({ { audioInputNode->nodeID, channel },
-                                             { nodes.getFirst()->nodeID, channel } });
-             processGraph->addConnection ({ { nodes.getLast()->nodeID, channel },
-                                             { audioOutputNode->nodeID, channel } });
-         }
+        oversamplingFactor = factor;
+        rebuildChain();
+    }
+    
+    int getOversamplingFactor() const { return oversamplingFactor; }
+    
+    ///Message thread only
+    void resetPlugin() {
+        ///Analyses still running would add their effect back after the clear
+        cancelAllAnalyses();
         
-        for (auto node : processGraph->getNodes())
-            node->getProcessor()->enableAllBuses();
-
-        ///Mute some node ?
-        /*for (int i = 0; i < 3; ++i) {
-            auto  slot   = slots   .getUnchecked (i);
-            auto& bypass = bypasses.getReference (i);
-
-            if (slot != nullptr)
-                slot->setBypassed (bypass->get());
-        }*/
-
+        {
+            const ScopedLock sl (chainLock);
+            effectsChain.clear();
         }
         
-        UIupdate_EffectBlocks = true;
-        
+        rebuildChain();
     }
     
-    bool NeedToUpdateGraph = true;
     bool processing = false;
-
-    bool UIupdate_processing = false;
-    bool UIupdate_EffectBlocks = false;
     
 protected:
     
     void run() override
     {
+        loadClassifier();
+        applyInferenceThreadSettings();
+        
+        bool liveRunning = false;
+        
         while (!threadShouldExit())
         {
-            if (hasTargetToProcess) {
-                hasTargetToProcess = false;
+            ///A new model file is picked up between two jobs, the one running finishes on the old model
+            SharedClassifier::checkForModelUpdates();
+            
+            if (requestedVariant != loadedVariantRequest || (classifier != nullptr && classifier->isOutdated())) {
+                loadClassifier();
+                applyInferenceThreadSettings();
+            }
+            
+            AnalysisJob::Ptr job;
+            bool ranJob = false;
+            
+            while (!threadShouldExit() && jobQueue.pop(job)) {
+                ///Published before checking the watermark, so a concurrent cancelJobsUpTo either sees it or is seen
+                {
+                    const ScopedLock sl (currentJobLock);
+                    currentJob = job;
+                }
+                
+                if (job->id <= cancelledUpToJobId)
+                    job->cancel();
                 
-                processAudioFile();
+                runJob(*job);
+                ranJob = true;
                 
+                const ScopedLock sl (currentJobLock);
+                currentJob = nullptr;
             }
-            wait (100);
+            
+            auto live = liveCapture.isEnabled() && isModelReady();
+            
+            if (live)
+                runLiveAnalysis(!liveRunning, ranJob);
+            liveRunning = live;
+            
+            ///The audio thread never notifies, poll while live mode is on, otherwise sleep until a submitted job notifies us
+            wait (live ? livePollIntervalMs : -1);
         }
     }
     
 private:
     
-    torch::jit::script::Module classifier;
+    void loadClassifier();
     
-    std::unique_ptr<juce::AudioProcessorGraph> processGraph;
+    SharedClassifier::Ptr classifier;
     
-    Node::Ptr audioInputNode;
-    Node::Ptr audioOutputNode;
-    Node::Ptr midiInputNode;
-    Node::Ptr midiOutputNode;
-
-    juce::Array<Node::Ptr> nodes;
+    std::atomic<enum modelState> classifierState { modelState::Loading };
+    std::atomic<ModelVariant> requestedVariant { ModelVariant::Float32 };
+    std::atomic<ModelVariant> activeVariant { ModelVariant::Float32 };
+    ModelVariant loadedVariantRequest = ModelVariant::Float32;
+    ModelLoadTimings modelLoadTimings;
+    double instantiationTime = 0.0;
+    
+    ///Worker only, kept between files so an analysis reuses the buffers of the previous one
+    FileAnalyser fileAnalyser { modelSampleRate };
+    
+    CriticalSection settingsLock;
+    AnalysisSettings analysisSettings;
+    InferenceThreadSettings threadSettings;
+    AnalysisCacheSettings cacheSettings;
+    
+    void applyInferenceThreadSettings();
+    
+    AudioCallbackMonitor callbackMonitor;
+    std::atomic<bool> analysisRunning { false };
+    
+    /** Builds and prepares a chain for the current effects and play settings, then hands it to the
+        audio thread. Message thread only, the worker asks for one through triggerAsyncUpdate().
+        The editor rebinds its blocks before returning, so the previous chain can be released.
+    */
+    void rebuildChain();
+    void handleAsyncUpdate() override { rebuildChain(); }
+    
+    ///Nothing on the audio thread ever builds, prepares or frees a chain
+    ChainExchange chains;
+    
+    ///Of the latest chain, hosts may ask from any thread
+    std::atomic<double> tailLengthSeconds { 0.0 };
+    
+    ///Message thread only, given to every new chain
+    int oversamplingFactor = 1;
+    
+    void runJob(AnalysisJob& job);
+    void cancelJobsUpTo(int lastJobId);
+    AnalysisJob::Ptr enqueueJob(AnalysisJob::Ptr job, bool preemptOlderJobs);
+    
+    ///Worker side, hand the job over to the message thread
+    void postProgress(AnalysisJob& job, double progress);
+    void postCompletion(AnalysisJob& job);
+    
+    ///Worker side, tell the listeners on the message thread
+    void postModelStateChange();
+    void postLiveResult();
+    
+    ///Message thread, once the callbacks of a finished job have run
+    void recordUINotification(int jobId, double publishedAtMs);
+    
+    ListenerList<AnalysisListener> analysisListeners;
+    
+    ///Set on the message thread in the constructor, copies handed to async callbacks are then safe from any thread
+    WeakReference<AutoEffectsAudioProcessor> weakThis;
+    void runLiveAnalysis(bool justStarted, bool resumedAfterJob);
+    
+    LiveInputCapture liveCapture;
+    LiveClassifier liveClassifier;
+    LiveAnalysisSettings liveSettings;
+    std::atomic<bool> liveSettingsChanged { false };
+    
+    std::atomic<int> liveEffect { EffectEnum::Dry };
+    std::atomic<float> liveScore { 0.f };
+    std::atomic<int> numLiveWindows { 0 };
+    
+    ///One message at a time, it reads the latest result when it runs
+    std::atomic<bool> liveResultPending { false };
+    
+    static constexpr int livePollIntervalMs = 20;
+    
+    AnalysisJobQueue jobQueue;
+    std::atomic<int> nextJobId { 0 };
+    
+    ///Jobs with an id up to this one are cancelled when popped
+    std::atomic<int> cancelledUpToJobId { 0 };
+    
+    CriticalSection currentJobLock;
+    AnalysisJob::Ptr currentJob;
     
-    File targetFile;
+    CriticalSection timingsLock;
+    std::deque<AnalysisTimingRecord> timingHistory;
+    static constexpr size_t maxTimingRecords = 1000;
     
-    bool hasTargetToProcess = false;
+    std::atomic<int> numProcessedJobs { 0 };
+    std::atomic<double> totalProcessingSeconds { 0.0 };
     
     //int numberOfEffect = 0;
     
+    ///Written by the worker, cleared and read by the message thread when building a chain
+    CriticalSection chainLock;
     Array<EffectEnum> effectsChain;
     
-    float modelSampleRate = 22050.f;
+    static constexpr float modelSampleRate = 22050.f;
     
-    processState processState = processState::Fail;
+    std::atomic<enum processState> processState { processState::Fail };
     
     //==============================================================================
+    JUCE_DECLARE_WEAK_REFERENCEABLE (AutoEffectsAudioProcessor)
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AutoEffectsAudioProcessor)
 };
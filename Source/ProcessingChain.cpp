@@ -0,0 +1,202 @@
+/*
+  ==============================================================================
+
+    ProcessingChain.cpp
+    Created: 20 Oct 2026 4:12:31pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#include "ProcessingChain.h"
+
+ProcessingChain::ProcessingChain (const Array<EffectEnum>& effectsToChain, int numChannels,
+                                  double rate, int blockSize, Engine engine, int oversamplingFactor)
+    : effects (effectsToChain), sampleRate (rate), maximumBlockSize (blockSize)
+{
+    if (engine == Engine::flat)
+        flatChain = std::make_unique<FlatEffectChain> (effects, numChannels, sampleRate, maximumBlockSize);
+    else
+        buildGraph (numChannels);
+
+    setOversamplingFactor (oversamplingFactor);
+    shareModulation();
+}
+
+void ProcessingChain::shareModulation()
+{
+    Array<ModulationProcessor*> modulated;
+
+    for (int i = 0; i < getNumEffects(); ++i)
+        if (auto* processor = dynamic_cast<ModulationProcessor*> (getEffectProcessor (i)))
+            modulated.add (processor);
+
+    if (modulated.isEmpty())
+        return;
+
+    modulation.prepare (sampleRate, maximumBlockSize, ModulationProcessor::numLfos * modulated.size());
+
+    for (auto* processor : modulated)
+        processor->shareCore (modulation);
+}
+
+void ProcessingChain::buildGraph (int numChannels)
+{
+    ///Built elsewhere, the rendering sequence would only be ready after the next message loop iteration
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    graph = std::make_unique<AudioProcessorGraph>();
+    graph->setPlayConfigDetails (numChannels, numChannels, sampleRate, maximumBlockSize);
+
+    auto audioInputNode  = graph->addNode (std::make_unique<AudioGraphIOProcessor> (AudioGraphIOProcessor::audioInputNode));
+    auto audioOutputNode = graph->addNode (std::make_unique<AudioGraphIOProcessor> (AudioGraphIOProcessor::audioOutputNode));
+    auto midiInputNode   = graph->addNode (std::make_unique<AudioGraphIOProcessor> (AudioGraphIOProcessor::midiInputNode));
+    auto midiOutputNode  = graph->addNode (std::make_unique<AudioGraphIOProcessor> (AudioGraphIOProcessor::midiOutputNode));
+
+    ///Dry gets no node, its nullptr entry keeps nodes in the order of the effects
+    for (auto effect : effects)
+    {
+        auto processor = createEffectProcessor (effect);
+
+        if (processor == nullptr)
+        {
+            nodes.add (nullptr);
+            continue;
+        }
+
+        auto node = graph->addNode (std::move (processor));
+        node->getProcessor()->setPlayConfigDetails (numChannels, numChannels, sampleRate, maximumBlockSize);
+        node->getProcessor()->enableAllBuses();
+        nodes.add (node);
+    }
+
+    ///Input, every effect in the order of the array, output. Input straight to output without effects
+    auto previous = audioInputNode;
+
+    for (auto node : nodes)
+    {
+        if (node == nullptr)
+            continue;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            graph->addConnection ({ { previous->nodeID, channel }, { node->nodeID, channel } });
+        previous = node;
+    }
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        graph->addConnection ({ { previous->nodeID, channel }, { audioOutputNode->nodeID, channel } });
+
+    graph->addConnection ({ { midiInputNode->nodeID,  AudioProcessorGraph::midiChannelIndex },
+                            { midiOutputNode->nodeID, AudioProcessorGraph::midiChannelIndex } });
+
+    ///Prepares every node and builds the rendering sequence, once the whole topology is known
+    graph->prepareToPlay (sampleRate, maximumBlockSize);
+}
+
+ProcessingChain::~ProcessingChain()
+{
+    if (graph != nullptr)
+        graph->releaseResources();
+}
+
+void ProcessingChain::process (AudioBuffer<float>& buffer, MidiBuffer& midiMessages)
+{
+    ///Nothing to do without modulation effects
+    modulation.advance (buffer.getNumSamples());
+
+    if (flatChain != nullptr)
+        flatChain->process (buffer, midiMessages);
+    else
+        graph->processBlock (buffer, midiMessages);
+}
+
+AudioProcessor* ProcessingChain::getEffectProcessor (int index) const
+{
+    if (flatChain != nullptr)
+        return flatChain->getEffectProcessor (index);
+
+    if (!isPositiveAndBelow (index, nodes.size()))
+        return nullptr;
+
+    auto node = nodes[index];
+    return node != nullptr ? node->getProcessor() : nullptr;
+}
+
+double ProcessingChain::getTailLengthSeconds() const
+{
+    double tail = 0.0;
+
+    for (int i = 0; i < getNumEffects(); ++i)
+        if (auto* processor = getEffectProcessor (i))
+            tail += processor->getTailLengthSeconds();
+
+    return tail;
+}
+
+int ProcessingChain::getLatencySamples() const
+{
+    int latency = 0;
+
+    for (int i = 0; i < getNumEffects(); ++i)
+        if (auto* processor = getEffectProcessor (i))
+            latency += processor->getLatencySamples();
+
+    return latency;
+}
+
+void ProcessingChain::setOversamplingFactor (int factor)
+{
+    for (int i = 0; i < getNumEffects(); ++i)
+        if (auto* waveshaper = dynamic_cast<WaveshaperProcessor*> (getEffectProcessor (i)))
+            waveshaper->setOversamplingFactor (factor);
+}
+
+//==============================================================================
+ChainExchange::~ChainExchange()
+{
+    stopTimer();
+
+    delete pending.exchange (nullptr);
+    delete retired.exchange (nullptr);
+    delete live;
+}
+
+void ChainExchange::publish (std::unique_ptr<ProcessingChain> newChain)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    latest = newChain.get();
+
+    ///Still pending means the audio thread never saw it
+    delete pending.exchange (newChain.release(), std::memory_order_acq_rel);
+
+    deleteRetired();
+    startTimer (collectIntervalMs);
+}
+
+ProcessingChain* ChainExchange::getChainForAudioThread() noexcept
+{
+    ///The retired slot is only filled here, so once seen empty it stays empty until the store below. The message
+    ///thread may replace the pending chain at any time but never empties it, so the exchange takes whichever is newest
+    if (pending.load (std::memory_order_acquire) != nullptr && retired.load (std::memory_order_acquire) == nullptr)
+    {
+        retired.store (live, std::memory_order_release);
+        live = pending.exchange (nullptr, std::memory_order_acq_rel);
+    }
+
+    return live;
+}
+
+void ChainExchange::deleteRetired()
+{
+    delete retired.exchange (nullptr, std::memory_order_acq_rel);
+}
+
+void ChainExchange::timerCallback()
+{
+    deleteRetired();
+
+    ///Nothing left to hand over, the next publish restarts the timer
+    if (pending.load() == nullptr)
+        stopTimer();
+}
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    ProcessingChain.h
+    Created: 20 Oct 2026 4:12:31pm
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "FlatEffectChain.h"
+
+//==============================================================================
+/**
+    One effect chain ready to run, prepared before the audio thread ever sees it and
+    never modified afterwards. Changing the effects means building a new chain and
+    handing it over with a ChainExchange.
+
+    The LFOs of every modulation effect of the chain run on one ModulationCore,
+    advanced once per block before the effects.
+
+    The flat engine processes the effects in place, see FlatEffectChain. The graph
+    engine gives each effect a node of its own AudioProcessorGraph; a graph only
+    builds its rendering sequence synchronously on the message thread, so these
+    chains must be created there.
+*/
+class ProcessingChain
+{
+public:
+    enum class Engine
+    {
+        flat,
+        graph
+    };
+
+    /** oversamplingFactor is applied to every waveshaping effect, see WaveshaperProcessor. */
+    ProcessingChain (const Array<EffectEnum>& effects, int numChannels, double sampleRate, int maximumBlockSize,
+                     Engine engine = Engine::flat, int oversamplingFactor = 1);
+    ~ProcessingChain();
+
+    ///Audio thread
+    void process (AudioBuffer<float>& buffer, MidiBuffer& midiMessages);
+
+    ///False if the host changed the rate or the block size since the chain was prepared
+    bool canProcess (int numSamples, double currentSampleRate) const noexcept
+    {
+        return numSamples <= maximumBlockSize && currentSampleRate == sampleRate;
+    }
+
+    const Array<EffectEnum>& getEffects() const noexcept  { return effects; }
+    int getNumEffects() const noexcept                     { return effects.size(); }
+
+    ///Valid as long as the chain, nullptr if the index is out of range
+    AudioProcessor* getEffectProcessor (int index) const;
+
+    ///Sum of the tails of the effects, which run one after the other
+    double getTailLengthSeconds() const;
+
+    ///Sum of the latencies of the effects, what the plugin must report
+    int getLatencySamples() const;
+
+private:
+    using AudioGraphIOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+
+    void buildGraph (int numChannels);
+    void shareModulation();
+    void setOversamplingFactor (int factor);
+
+    const Array<EffectEnum> effects;
+    const double sampleRate;
+    const int maximumBlockSize;
+
+    ///Only one of them is used
+    std::unique_ptr<FlatEffectChain> flatChain;
+    std::unique_ptr<AudioProcessorGraph> graph;
+    Array<AudioProcessorGraph::Node::Ptr> nodes;
+
+    ModulationCore modulation;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProcessingChain)
+};
+
+//==============================================================================
+/**
+    Hands prepared chains from the message thread to the audio thread.
+
+    The audio thread takes the latest published chain at the start of a block with
+    a couple of atomic operations, it never locks, allocates or frees. The chain it
+    replaces goes back through a single slot and is deleted on the message thread;
+    a new chain is only taken once that slot was emptied, so a burst of publishes
+    just keeps the last one pending for a few milliseconds.
+*/
+class ChainExchange  : private Timer
+{
+public:
+    ChainExchange() = default;
+
+    ///The audio thread must not be running anymore
+    ~ChainExchange() override;
+
+    ///Message thread. A chain published before and not picked up yet is deleted
+    void publish (std::unique_ptr<ProcessingChain> newChain);
+
+    ///Audio thread, wait-free. nullptr until a first chain was published
+    ProcessingChain* getChainForAudioThread() noexcept;
+
+    ///Message thread. The last published chain, live or about to be, kept alive until another one is published
+    ProcessingChain* getLatest() const noexcept  { return latest; }
+
+private:
+    void timerCallback() override;
+    void deleteRetired();
+
+    std::atomic<ProcessingChain*> pending { nullptr };
+    std::atomic<ProcessingChain*> retired { nullptr };
+
+    ProcessingChain* live = nullptr;    ///Audio thread only
+    ProcessingChain* latest = nullptr;  ///Message thread only
+
+    static constexpr int collectIntervalMs = 50;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChainExchange)
+};
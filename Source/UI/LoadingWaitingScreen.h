@@ -45,11 +45,22 @@ public:
         }
  
         g.strokePath (spinePath, juce::PathStrokeType (4.0f));
+        
+        if (progress > 0.0)
+            g.drawText (String (roundToInt (progress * 100.0)) + " %", getLocalBounds().withTop (getHeight() / 2 + 60).withHeight (20),
+                        Justification::centred);
+    }
+    
+    ///Fraction of the current file analysed, from 0 to 1, shown under the spinner
+    void setProgress (double newProgress) {
+        progress = newProgress;
+        repaint();
     }
         
     ///Make sure that you call stopAnimation() when animation is not needed for better performance
     void startAnimation() {
         animationCounter = 0;
+        progress = 0.0;
         startTimer(30);
     }
     
@@ -72,6 +83,7 @@ public:
 private:
     
     int animationCounter = 0;
+    double progress = 0.0;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoadingWaitingScreen)
 };
@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    TimingOverlay.h
+    Created: 19 Oct 2026 11:24:37am
+    Author:  Hugo PRAT
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifdef WITH_CMAKE
+    #include "CustomJuceHeader.h"
+#else
+    #include "../JuceLibraryCode/JuceHeader.h"
+#endif
+
+#include "../Analysis/AnalysisTimings.h"
+
+///Shows where the time of the latest analyses went, one stacked bar per analysis
+class TimingOverlay : public Component {
+public:
+    TimingOverlay()
+    {
+        exportButton.reset (new juce::TextButton (TRANS("Export...")));
+        addAndMakeVisible (exportButton.get());
+        exportButton->setColour (juce::TextButton::buttonColourId, juce::Colour (77,94,251));
+        exportButton->setColour (juce::TextButton::textColourOffId, juce::Colour (245, 246, 252));
+        exportButton->onClick = [this] { if (onExport) onExport(); };
+    }
+
+    ~TimingOverlay() = default;
+
+    ///Called when the export button is clicked
+    std::function<void()> onExport;
+
+    ///Only the last maxRecordsShown records are drawn
+    void setRecords(const std::vector<AnalysisTimingRecord>& newRecords)
+    {
+        auto first = newRecords.size() > (size_t) maxRecordsShown ? newRecords.end() - maxRecordsShown : newRecords.begin();
+        records.assign (first, newRecords.end());
+        repaint();
+    }
+
+    void paint (juce::Graphics& g) override
+    {
+        g.fillAll (Colours::white.withAlpha(0.95f));
+
+        auto area = getLocalBounds().reduced(10);
+        area.removeFromBottom(30);
+
+        ///Legend
+        auto legend = area.removeFromTop(16);
+        g.setFont (juce::Font (11.00f, juce::Font::plain));
+
+        for (int stage = 0; stage < AnalysisTimingRecord::numStages; ++stage) {
+            auto item = legend.removeFromLeft(legend.getWidth() / (AnalysisTimingRecord::numStages - stage));
+            g.setColour (getStageColour(stage));
+            g.fillRect (item.removeFromLeft(8).withSizeKeepingCentre(8, 8));
+            g.setColour (Colour(113,114,123));
+            g.drawText (AnalysisTimingRecord::getStageName(stage), item.withTrimmedLeft(2), Justification::centredLeft, true);
+        }
+
+        if (records.empty()) {
+            g.drawText (TRANS("No analysis yet"), area, Justification::centred);
+            return;
+        }
+
+        ///Every bar uses the scale of the slowest analysis shown
+        double longestMs = 1.0;
+        for (auto& record : records)
+            longestMs = jmax(longestMs, getShownMs(record));
+
+        auto rowHeight = jmin(34, area.getHeight() / (int) records.size());
+
+        for (auto& record : records) {
+            auto row = area.removeFromTop(rowHeight).reduced(0, 2);
+            auto text = row.removeFromTop(row.getHeight() / 2);
+
+            g.setColour (Colour(113,114,123));
+            g.drawText (record.fileName, text, Justification::centredLeft, true);
+            g.drawText ((record.fromCache ? TRANS("cached") + ", " : String()) + String(getShownMs(record), 1) + " ms",
+                        text, Justification::centredRight, false);
+
+            auto x = (float) row.getX();
+
+            for (int stage = 0; stage < AnalysisTimingRecord::numStages; ++stage) {
+                auto width = (float) (jmax(0.0, record.stageMs[stage]) / longestMs) * (float) row.getWidth();
+                g.setColour (getStageColour(stage));
+                g.fillRect (x, (float) row.getY(), width, (float) row.getHeight());
+                x += width;
+            }
+        }
+    }
+
+    void resized () override
+    {
+        exportButton->setBounds(getLocalBounds().reduced(10).removeFromBottom(24).removeFromRight(90));
+    }
+
+private:
+
+    static Colour getStageColour(int stage)
+    {
+        return Colour::fromHSV ((float) stage / (float) AnalysisTimingRecord::numStages, 0.6f, 0.85f, 1.f);
+    }
+
+    ///Sum of the stages, which also counts the UI notification unlike totalMs
+    static double getShownMs(const AnalysisTimingRecord& record)
+    {
+        double sum = 0.0;
+        for (auto ms : record.stageMs)
+            sum += jmax(0.0, ms);
+        return sum;
+    }
+
+    static constexpr int maxRecordsShown = 6;
+
+    std::vector<AnalysisTimingRecord> records;
+    std::unique_ptr<juce::TextButton> exportButton;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TimingOverlay)
+};
@@ -0,0 +1,27 @@
+#include <gtest/gtest.h>
+
+#include "Analysis/AlignedFloatBuffer.h"
+
+TEST(AlignedFloatBuffer, IsAlignedAndKeepsContentWhenGrowing) {
+    AlignedFloatBuffer buffer;
+    buffer.ensureSize (100);
+    EXPECT_EQ(reinterpret_cast<uintptr_t> (buffer.data()) % AlignedFloatBuffer::alignment, 0u);
+
+    for (int i = 0; i < 100; ++i)
+        buffer.data()[i] = (float) i;
+
+    buffer.ensureSize (10000);
+    EXPECT_EQ(reinterpret_cast<uintptr_t> (buffer.data()) % AlignedFloatBuffer::alignment, 0u);
+    EXPECT_EQ(buffer.size(), 10000u);
+    EXPECT_FLOAT_EQ(buffer.data()[99], 99.f);
+}
+
+TEST(AlignedFloatBuffer, NeverShrinks) {
+    AlignedFloatBuffer buffer;
+    buffer.ensureSize (1000);
+    auto* data = buffer.data();
+
+    buffer.ensureSize (10);
+    EXPECT_EQ(buffer.data(), data);
+    EXPECT_EQ(buffer.size(), 1000u);
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include "Analysis/AnalysisJobQueue.h"
+
+#include <thread>
+
+static AnalysisJob::Ptr makeJob (int id)
+{
+    return new AnalysisJob (id, File(), nullptr);
+}
+
+TEST(AnalysisJobQueue, PopsInSubmissionOrder) {
+    AnalysisJobQueue queue (8);
+
+    for (int i = 0; i < 5; ++i) {
+        auto job = makeJob (i);
+        EXPECT_TRUE(queue.push (job));
+        EXPECT_EQ(job, nullptr);
+    }
+    EXPECT_EQ(queue.getNumPending(), 5);
+
+    AnalysisJob::Ptr job;
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(queue.pop (job));
+        EXPECT_EQ(job->id, i);
+    }
+    EXPECT_FALSE(queue.pop (job));
+}
+
+TEST(AnalysisJobQueue, RejectsWhenFull) {
+    AnalysisJobQueue queue (4);
+
+    for (int i = 0; i < queue.getCapacity(); ++i) {
+        auto job = makeJob (i);
+        EXPECT_TRUE(queue.push (job));
+    }
+
+    auto extra = makeJob (99);
+    EXPECT_FALSE(queue.push (extra));
+    ///The job is left to the caller when it couldn't be queued
+    EXPECT_NE(extra, nullptr);
+}
+
+TEST(AnalysisJobQueue, NoJobLostWithConcurrentProducers) {
+    AnalysisJobQueue queue (1024);
+    constexpr int numProducers = 4;
+    constexpr int jobsPerProducer = 200;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < numProducers; ++p)
+        producers.emplace_back ([&queue, p] {
+            for (int i = 0; i < jobsPerProducer; ++i) {
+                auto job = makeJob (p * jobsPerProducer + i);
+                while (! queue.push (job))
+                    std::this_thread::yield();
+            }
+        });
+
+    std::vector<bool> seen (numProducers * jobsPerProducer, false);
+    int numPopped = 0;
+    AnalysisJob::Ptr job;
+
+    while (numPopped < numProducers * jobsPerProducer) {
+        if (queue.pop (job)) {
+            EXPECT_FALSE(seen[(size_t) job->id]);
+            seen[(size_t) job->id] = true;
+            ++numPopped;
+        }
+    }
+
+    for (auto& t : producers)
+        t.join();
+
+    EXPECT_EQ(queue.getNumPending(), 0);
+}
+
+TEST(AnalysisJobQueue, CancelledJobIsFinishedOnceMarkedSo) {
+    auto job = makeJob (1);
+    EXPECT_FALSE(job->isCancelled());
+
+    ///Cancelling only asks, the worker decides when the job is over
+    job->cancel();
+    EXPECT_TRUE(job->isCancelled());
+    EXPECT_FALSE(job->isFinished());
+
+    job->status = AnalysisJobStatus::Cancelled;
+    EXPECT_TRUE(job->isFinished());
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include "Analysis/AnalysisResultCache.h"
+
+static AnalysisResult makeResult()
+{
+    AnalysisResult result;
+    result.effect = EffectEnum::Reverb;
+    result.numWindows = 2;
+    result.numClasses = 3;
+    result.windowLogits = { 0.1f, 0.2f, 0.7f, 0.3f, 0.3f, 0.4f };
+    result.classScores = { 0.2f, 0.25f, 0.55f };
+    return result;
+}
+
+TEST(ContentHasher, DoesNotDependOnChunking) {
+    std::vector<float> samples (1001);
+    for (size_t i = 0; i < samples.size(); ++i)
+        samples[i] = std::sin ((float) i * 0.01f);
+
+    ContentHasher whole;
+    whole.update (samples.data(), samples.size() * sizeof (float));
+
+    ContentHasher chunked;
+    auto* bytes = reinterpret_cast<const char*> (samples.data());
+    size_t total = samples.size() * sizeof (float);
+    for (size_t pos = 0; pos < total; pos += 13)
+        chunked.update (bytes + pos, std::min<size_t> (13, total - pos));
+
+    EXPECT_EQ(whole.getHash(), chunked.getHash());
+
+    samples[500] += 1.0e-3f;
+    ContentHasher modified;
+    modified.update (samples.data(), samples.size() * sizeof (float));
+    EXPECT_NE(whole.getHash(), modified.getHash());
+}
+
+TEST(AnalysisResultCache, StoresAndFindsResultsByFileAndContent) {
+    auto dir = File::createTempFile ("cache");
+    {
+        AnalysisResultCache cache (dir);
+        AnalysisResult found;
+
+        EXPECT_FALSE(cache.lookupContent ("c1234", found));
+
+        cache.store ("f5678", "c1234", makeResult());
+    }
+
+    ///New object, so the result has to come back from disk
+    AnalysisResultCache cache (dir);
+    AnalysisResult found;
+
+    ASSERT_TRUE(cache.lookupFile ("f5678", found));
+    EXPECT_TRUE(found.fromCache);
+    EXPECT_EQ(found.effect, EffectEnum::Reverb);
+    EXPECT_EQ(found.windowLogits, makeResult().windowLogits);
+    EXPECT_EQ(found.classScores, makeResult().classScores);
+
+    dir.deleteRecursively();
+}
+
+TEST(AnalysisResultCache, HitsMarkTheEntryAndItsReferenceAsUsed) {
+    auto dir = File::createTempFile ("cache");
+    AnalysisResultCache cache (dir);
+    cache.store ("fA", "cA", makeResult());
+
+    auto entry = dir.getChildFile ("cA.result");
+    auto reference = dir.getChildFile ("fA.ref");
+    auto longAgo = Time::getCurrentTime() - RelativeTime::days (30);
+    entry.setLastModificationTime (longAgo);
+    reference.setLastModificationTime (longAgo);
+
+    ///Answered from memory, the files are still the LRU clock of every instance sharing the directory
+    AnalysisResult found;
+    ASSERT_TRUE(cache.lookupFile ("fA", found));
+    EXPECT_GT(entry.getLastModificationTime(), longAgo + RelativeTime::days (1));
+    EXPECT_GT(reference.getLastModificationTime(), longAgo + RelativeTime::days (1));
+
+    dir.deleteRecursively();
+}
+
+TEST(AnalysisResultCache, EvictsLeastRecentlyUsedEntries) {
+    auto dir = File::createTempFile ("cache");
+    AnalysisResultCache cache (dir);
+
+    AnalysisCacheSettings settings;
+    settings.maxEntries = 2;
+    cache.setSettings (settings);
+
+    cache.store ({}, "cA", makeResult());
+    Thread::sleep (20);
+    cache.store ({}, "cB", makeResult());
+    Thread::sleep (20);
+    cache.store ({}, "cC", makeResult());
+
+    EXPECT_EQ(cache.getNumEntries(), 2);
+    EXPECT_FALSE(dir.getChildFile ("cA.result").existsAsFile());
+
+    dir.deleteRecursively();
+}
+
+TEST(AnalysisResultCache, DisabledCacheLeavesNoDirectory) {
+    auto dir = File::createTempFile ("cache");
+    AnalysisResultCache cache (dir);
+
+    AnalysisCacheSettings settings;
+    settings.enabled = false;
+    cache.setSettings (settings);
+
+    cache.store ("f1", "c1", makeResult());
+    EXPECT_FALSE(dir.exists());
+}
+
+TEST(AnalysisResultCache, EvictsBelowTheLimitsOnceExceeded) {
+    auto dir = File::createTempFile ("cache");
+    AnalysisResultCache cache (dir);
+
+    AnalysisCacheSettings settings;
+    settings.maxEntries = 20;
+    cache.setSettings (settings);
+
+    for (int i = 0; i < 20; ++i)
+        cache.store ({}, "c" + String (i), makeResult());
+    EXPECT_EQ(cache.getNumEntries(), 20);
+
+    ///One over the limit, down to a tenth below it
+    cache.store ({}, "c20", makeResult());
+    EXPECT_EQ(cache.getNumEntries(), 18);
+
+    dir.deleteRecursively();
+}
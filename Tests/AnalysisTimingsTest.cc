@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include "Analysis/AnalysisTimings.h"
+
+TEST(AnalysisTimings, ScopedStageTimerAddsToItsStage) {
+    AnalysisTimingRecord record;
+
+    for (int i = 0; i < 2; ++i)
+    {
+        ScopedStageTimer timer (&record, AnalysisTimingRecord::Forward);
+        Thread::sleep (5);
+    }
+
+    EXPECT_GE(record[AnalysisTimingRecord::Forward], 9.0);
+    EXPECT_EQ(record[AnalysisTimingRecord::Decode], 0.0);
+    EXPECT_EQ(record[AnalysisTimingRecord::UINotification], -1.0);
+
+    ///No record, nothing to update
+    ScopedStageTimer timer (nullptr, AnalysisTimingRecord::Forward);
+}
+
+TEST(AnalysisTimings, CSVHasOneLinePerRecordAndQuotesFileNames) {
+    AnalysisTimingRecord record;
+    record.jobId = 3;
+    record.fileName = "guitar, take \"2\".wav";
+    record[AnalysisTimingRecord::Forward] = 12.5;
+
+    auto lines = StringArray::fromLines (AnalysisTimingRecord::toCSV ({ record, record }).trimEnd());
+
+    ASSERT_EQ(lines.size(), 3);
+    EXPECT_TRUE(lines[0].startsWith ("jobId,file,"));
+    EXPECT_TRUE(lines[0].contains ("forwardMs"));
+    EXPECT_TRUE(lines[1].startsWith ("3,\"guitar, take \"\"2\"\".wav\","));
+    EXPECT_TRUE(lines[1].contains (",12.500,"));
+}
+
+TEST(AnalysisTimings, JSONDescribesTheMachineAndEveryStage) {
+    AnalysisTimingRecord record;
+    record.fileName = "drums.wav";
+    record[AnalysisTimingRecord::Resample] = 4.0;
+
+    auto parsed = JSON::parse (AnalysisTimingRecord::toJSON ({ record }));
+
+    EXPECT_GT((int) parsed["machine"]["logicalCores"], 0);
+    ASSERT_EQ(parsed["analyses"].size(), 1);
+    EXPECT_EQ(parsed["analyses"][0]["file"].toString(), "drums.wav");
+    EXPECT_DOUBLE_EQ((double) parsed["analyses"][0]["stagesMs"]["resample"], 4.0);
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include "Analysis/CompactBackend.h"
+
+namespace
+{
+    ///Writes a compact model, layers are (type, params, weights then bias)
+    struct ModelWriter
+    {
+        MemoryOutputStream out;
+        int numLayers = 0;
+        MemoryOutputStream layers;
+
+        void add (CompactBackend::LayerType type, std::initializer_list<int> params, std::initializer_list<float> values = {})
+        {
+            layers.writeInt ((int) type);
+            for (int p = 0; p < 4; ++p)
+                layers.writeInt (p < (int) params.size() ? params.begin()[p] : 0);
+            for (auto value : values)
+                layers.writeFloat (value);
+            ++numLayers;
+        }
+
+        MemoryBlock finish (const String& metadata = "{\"formatVersion\": 1, \"numClasses\": 11}")
+        {
+            auto metadataSize = (int) metadata.getNumBytesAsUTF8();
+            out.write ("AENT", 4);
+            out.writeInt ((int) CompactBackend::fileFormatVersion);
+            out.writeInt (metadataSize);
+            out.write (metadata.toRawUTF8(), (size_t) metadataSize);
+            out.writeRepeatedByte (0, (size_t) ((4 - metadataSize % 4) % 4));
+            out.writeInt (numLayers);
+            out << layers.getMemoryBlock();
+            return out.getMemoryBlock();
+        }
+    };
+
+    CompactBackend load (const MemoryBlock& data)
+    {
+        return CompactBackend (static_cast<const char*> (data.getData()), data.getSize());
+    }
+}
+
+TEST(CompactBackend, RecognisesItsFormatAndReadsTheMetadata) {
+    ModelWriter writer;
+    writer.add (CompactBackend::MeanPool, {});
+    auto data = writer.finish ("{\"formatVersion\": 1}");
+
+    EXPECT_TRUE(CompactBackend::isCompactModel (static_cast<const char*> (data.getData()), data.getSize()));
+    EXPECT_EQ(CompactBackend::readMetadata (static_cast<const char*> (data.getData()), data.getSize()), "{\"formatVersion\": 1}");
+    EXPECT_FALSE(CompactBackend::isCompactModel ("PK\3\4 not a compact model", 24));
+}
+
+TEST(CompactBackend, RunsConvolutionReluPoolAndLinear) {
+    ModelWriter writer;
+
+    ///2 input channels, 1 output channel, kernel 2, stride 1: weights [out][k][in]
+    writer.add (CompactBackend::Conv1d, { 2, 1, 2, 1 }, { 1.f, 0.f,  0.f, -1.f,  /* bias */ 0.5f });
+    writer.add (CompactBackend::ReLU, {});
+    writer.add (CompactBackend::MeanPool, {});
+    writer.add (CompactBackend::Linear, { 1, 2 }, { 2.f, -1.f,  /* bias */ 0.f, 1.f });
+    auto data = writer.finish();
+
+    CompactBackend backend (static_cast<const char*> (data.getData()), data.getSize());
+    EXPECT_EQ(backend.getNumLayers(), 4);
+    EXPECT_EQ(backend.getNumParameters(), 9);
+
+    ///3 frames of 2 channels, out[t] = x[t][0] - x[t + 1][1] + 0.5 gives 1.5 and -2, relu 1.5 and 0, mean 0.75
+    const float frames[] = { 1.f, 9.f,   4.f, 0.f,   2.f, 6.5f };
+    ClassifierInput input;
+    input.data = frames;
+    input.numFrames = 3;
+    input.numChannels = 2;
+    input.rowStride = 6;
+    input.isSpectrogram = true;
+
+    std::vector<float> output;
+    backend.forward (input, output, 1);
+
+    ASSERT_EQ(output.size(), 2u);
+    EXPECT_FLOAT_EQ(output[0], 1.5f);
+    EXPECT_FLOAT_EQ(output[1], 0.25f);
+}
+
+TEST(CompactBackend, OverlappingRowsGiveOneResultEach) {
+    ModelWriter writer;
+    writer.add (CompactBackend::Linear, { 2, 1 }, { 1.f, 1.f,  0.f });
+    auto data = writer.finish();
+    auto backend = load (data);
+
+    ///Rows of 2 samples starting every sample
+    const float samples[] = { 1.f, 2.f, 3.f, 4.f };
+    ClassifierInput input;
+    input.data = samples;
+    input.numRows = 3;
+    input.numFrames = 2;
+    input.rowStride = 1;
+
+    std::vector<float> output;
+    backend.forward (input, output, 1);
+
+    EXPECT_EQ(output, (std::vector<float> { 3.f, 5.f, 7.f }));
+}
+
+TEST(CompactBackend, RejectsBrokenModelsAndInputs) {
+    ModelWriter truncated;
+    truncated.add (CompactBackend::Linear, { 4, 4 }, { 1.f });
+    auto truncatedData = truncated.finish();
+    EXPECT_THROW(load (truncatedData), std::runtime_error);
+
+    ModelWriter unchained;
+    unchained.add (CompactBackend::Conv1d, { 1, 2, 1, 1 }, { 1.f, 1.f, 0.f, 0.f });
+    unchained.add (CompactBackend::Conv1d, { 3, 1, 1, 1 }, { 1.f, 1.f, 1.f, 0.f });
+    auto unchainedData = unchained.finish();
+    EXPECT_THROW(load (unchainedData), std::runtime_error);
+
+    ModelWriter linear;
+    linear.add (CompactBackend::Linear, { 3, 1 }, { 1.f, 1.f, 1.f, 0.f });
+    auto linearData = linear.finish();
+    auto backend = load (linearData);
+
+    const float samples[] = { 1.f, 2.f };
+    ClassifierInput input;
+    input.data = samples;
+    input.numFrames = 2;
+    input.rowStride = 2;
+
+    std::vector<float> output;
+    EXPECT_THROW(backend.forward (input, output, 1), std::runtime_error);
+}
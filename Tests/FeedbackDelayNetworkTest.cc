@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include "DSP/FeedbackDelayNetwork.h"
+
+static constexpr double testRate = 48000.0;
+
+///RMS of both channels over [start, start + length) seconds of the impulse response
+static double rmsOverWindow (const std::vector<float>& left, const std::vector<float>& right, double start, double length)
+{
+    auto first = (size_t) (start * testRate);
+    auto last = jmin (left.size(), (size_t) ((start + length) * testRate));
+    double sum = 0.0;
+
+    for (auto i = first; i < last; ++i)
+        sum += (double) left[i] * left[i] + (double) right[i] * right[i];
+
+    return std::sqrt (sum / (double) jmax ((size_t) 1, 2 * (last - first)));
+}
+
+static void impulseResponse (FeedbackDelayNetwork& reverb, double seconds, std::vector<float>& left, std::vector<float>& right)
+{
+    left.assign ((size_t) (seconds * testRate), 0.f);
+    right.assign (left.size(), 0.f);
+    left[0] = right[0] = 1.f;
+
+    ///Blocks like a host would send them
+    for (size_t start = 0; start < left.size(); start += 512) {
+        auto num = (int) jmin ((size_t) 512, left.size() - start);
+        reverb.process (left.data() + start, right.data() + start, num);
+    }
+}
+
+TEST(FeedbackDelayNetwork, DecaysBy60DecibelsOverTheDecayTime) {
+    FeedbackDelayNetwork reverb;
+    reverb.setDecayTime (1.f);
+    reverb.setDamping (0.f);
+    reverb.setMix (1.f);
+    reverb.prepare (testRate);
+
+    std::vector<float> left, right;
+    impulseResponse (reverb, 2.0, left, right);
+
+    auto early = rmsOverWindow (left, right, 0.1, 0.2);
+    auto afterDecayTime = rmsOverWindow (left, right, 1.1, 0.2);
+    auto decibels = 20.0 * std::log10 (afterDecayTime / early);
+
+    ///Diffuse tails don't fall exactly on the line, a few dB either way is the same decay
+    EXPECT_NEAR(decibels, -60.0, 6.0);
+}
+
+TEST(FeedbackDelayNetwork, ChannelsAreDecorrelated) {
+    FeedbackDelayNetwork reverb;
+    reverb.setMix (1.f);
+    reverb.prepare (testRate);
+
+    std::vector<float> left, right;
+    impulseResponse (reverb, 0.5, left, right);
+
+    double product = 0.0, leftEnergy = 0.0, rightEnergy = 0.0;
+    for (size_t i = 0; i < left.size(); ++i) {
+        product += (double) left[i] * right[i];
+        leftEnergy += (double) left[i] * left[i];
+        rightEnergy += (double) right[i] * right[i];
+    }
+
+    EXPECT_GT(leftEnergy, 0.0);
+    EXPECT_LT(std::abs (product) / std::sqrt (leftEnergy * rightEnergy), 0.5);
+}
+
+TEST(FeedbackDelayNetwork, ReportsTheDecayTimeAndLongestLineAsTail) {
+    FeedbackDelayNetwork reverb;
+    reverb.prepare (testRate);
+    reverb.setDecayTime (3.f);
+    reverb.setSize (1.f);
+
+    ///The longest line of a size 1 room is 63.7 ms
+    EXPECT_NEAR(reverb.getTailLengthSeconds(), 3.0637, 1.0e-3);
+
+    reverb.setSize (FeedbackDelayNetwork::maximumSize);
+    EXPECT_NEAR(reverb.getTailLengthSeconds(), 3.1274, 1.0e-3);
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include "Analysis/LiveClassifier.h"
+
+static AudioBuffer<float> makeConstantBlock (int numSamples, float value)
+{
+    AudioBuffer<float> buffer (2, numSamples);
+    buffer.clear();
+    FloatVectorOperations::fill (buffer.getWritePointer (0), value, numSamples);
+    FloatVectorOperations::fill (buffer.getWritePointer (1), value, numSamples);
+    return buffer;
+}
+
+TEST(LiveClassifier, StalledWorkerNeverClassifiesStaleAudio) {
+    const double rate = 22050.0;
+
+    LiveInputCapture capture;
+    capture.prepare (rate, 0.2);
+    capture.setEnabled (true);
+
+    LiveAnalysisSettings settings;
+    settings.windowLength = 2048;
+    settings.hopLength = 512;
+
+    LiveClassifier live;
+    live.reset (rate, rate, settings);
+    live.restart (capture);
+
+    ///The worker stalls while the ring fills with audio that stops being current once it overflows
+    for (int written = 0; written < capture.getCapacity() * 2; written += 512)
+        capture.pushBlock (makeConstantBlock (512, 1.f), 2);
+
+    ASSERT_GT(capture.getNumDroppedSamples(), 0);
+    EXPECT_FALSE(live.pullCaptured (capture));
+
+    ///Only what arrives once the worker is back makes a window
+    bool windowDue = false;
+    for (int written = 0; written < settings.windowLength * 2 && !windowDue; written += 512)
+    {
+        capture.pushBlock (makeConstantBlock (512, -1.f), 2);
+        windowDue = live.pullCaptured (capture);
+    }
+
+    ASSERT_TRUE(windowDue);
+
+    auto* window = live.getWindow();
+    for (int i = 0; i < settings.windowLength; ++i)
+        ASSERT_LT(window[i], 0.5f) << "stale sample at " << i;
+}
+
+TEST(LiveClassifier, RestartForgetsAudioCapturedDuringAJob) {
+    const double rate = 22050.0;
+
+    LiveInputCapture capture;
+    capture.prepare (rate, 0.5);
+    capture.setEnabled (true);
+
+    LiveAnalysisSettings settings;
+    settings.windowLength = 2048;
+    settings.hopLength = 512;
+
+    LiveClassifier live;
+    live.reset (rate, rate, settings);
+    live.restart (capture);
+
+    ///Fits in the ring, nothing is dropped, but it was played while a file was analysed
+    capture.pushBlock (makeConstantBlock (4096, 1.f), 2);
+    ASSERT_EQ(capture.getNumDroppedSamples(), 0);
+
+    live.restart (capture);
+    EXPECT_FALSE(live.pullCaptured (capture));
+
+    capture.pushBlock (makeConstantBlock (4096, -1.f), 2);
+    ASSERT_TRUE(live.pullCaptured (capture));
+
+    auto* window = live.getWindow();
+    for (int i = 0; i < settings.windowLength; ++i)
+        ASSERT_LT(window[i], 0.5f) << "stale sample at " << i;
+}
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include "Analysis/LiveInputCapture.h"
+
+static AudioBuffer<float> makeStereoBlock (int numSamples, float left, float right)
+{
+    AudioBuffer<float> buffer (2, numSamples);
+    FloatVectorOperations::fill (buffer.getWritePointer (0), left, numSamples);
+    FloatVectorOperations::fill (buffer.getWritePointer (1), right, numSamples);
+    return buffer;
+}
+
+TEST(LiveInputCapture, IgnoresBlocksWhenDisabled) {
+    LiveInputCapture capture;
+    capture.prepare (48000.0, 0.1);
+
+    capture.pushBlock (makeStereoBlock (512, 1.f, 1.f), 2);
+
+    std::vector<float> pulled (512);
+    EXPECT_EQ(capture.pull (pulled.data(), 512), 0);
+}
+
+TEST(LiveInputCapture, PullsTheMidOfTheInput) {
+    LiveInputCapture capture;
+    capture.prepare (48000.0, 0.1);
+    capture.setEnabled (true);
+
+    capture.pushBlock (makeStereoBlock (256, 1.f, 0.f), 2);
+    capture.pushBlock (makeStereoBlock (256, 0.2f, 0.6f), 2);
+
+    std::vector<float> pulled (1024);
+    ASSERT_EQ(capture.pull (pulled.data(), 1024), 512);
+    EXPECT_FLOAT_EQ(pulled[0], 0.5f);
+    EXPECT_FLOAT_EQ(pulled[511], 0.4f);
+}
+
+TEST(LiveInputCapture, DropsWhatDoesNotFit) {
+    LiveInputCapture capture;
+    capture.prepare (10000.0, 0.1);
+    capture.setEnabled (true);
+
+    const int capacity = capture.getCapacity();
+    for (int written = 0; written < capacity * 2; written += 500)
+        capture.pushBlock (makeStereoBlock (500, 1.f, 1.f), 2);
+
+    std::vector<float> pulled ((size_t) capacity * 2);
+    EXPECT_EQ(capture.pull (pulled.data(), capacity * 2), capacity);
+    EXPECT_GT(capture.getNumDroppedSamples(), 0);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include "Analysis/LogMelSpectrogram.h"
+
+namespace
+{
+    std::vector<float> makeSine (double frequency, double sampleRate, int numSamples)
+    {
+        std::vector<float> samples ((size_t) numSamples);
+        for (int i = 0; i < numSamples; ++i)
+            samples[(size_t) i] = (float) std::sin (MathConstants<double>::twoPi * frequency * i / sampleRate);
+        return samples;
+    }
+}
+
+TEST(LogMelSpectrogram, CountsWholeFramesOnly) {
+    LogMelSettings settings;
+    settings.fftOrder = 10;
+    settings.hopLength = 256;
+    LogMelSpectrogram logMel (settings);
+
+    EXPECT_EQ(logMel.getNumFrames (1023), 0);
+    EXPECT_EQ(logMel.getNumFrames (1024), 1);
+    EXPECT_EQ(logMel.getNumFrames (1024 + 255), 1);
+    EXPECT_EQ(logMel.getNumFrames (1024 + 256), 2);
+    EXPECT_EQ(logMel.getNumFrames (44100), 169);
+}
+
+TEST(LogMelSpectrogram, SilenceGivesTheLogOfTheOffset) {
+    LogMelSettings settings;
+    LogMelSpectrogram logMel (settings);
+
+    std::vector<float> silence ((size_t) settings.getFFTSize(), 0.f);
+    std::vector<float> output ((size_t) settings.numMels);
+    logMel.processFrame (silence.data(), output.data());
+
+    for (auto value : output)
+        EXPECT_NEAR(value, std::log (settings.logOffset), 1.0e-4f);
+}
+
+TEST(LogMelSpectrogram, SineEnergyLandsInTheMatchingMelBand) {
+    LogMelSettings settings;
+    settings.numMels = 64;
+    LogMelSpectrogram logMel (settings);
+
+    const double frequency = 1000.0;
+    auto sine = makeSine (frequency, settings.sampleRate, settings.getFFTSize());
+    std::vector<float> output ((size_t) settings.numMels);
+    logMel.processFrame (sine.data(), output.data());
+
+    auto loudest = (int) std::distance (output.begin(), std::max_element (output.begin(), output.end()));
+
+    ///Band centres are evenly spaced in mel between 0 and Nyquist
+    auto melStep = LogMelSpectrogram::frequencyToMel (settings.sampleRate / 2) / (settings.numMels + 1);
+    auto expected = LogMelSpectrogram::frequencyToMel (frequency) / melStep - 1.0;
+
+    EXPECT_NEAR(loudest, expected, 1.0);
+}
+
+TEST(LogMelSpectrogram, ProcessWritesFrameAfterFrame) {
+    LogMelSettings settings;
+    settings.hopLength = 512;
+    LogMelSpectrogram logMel (settings);
+
+    auto sine = makeSine (440.0, settings.sampleRate, 4096);
+    auto numFrames = logMel.getNumFrames ((int) sine.size());
+    std::vector<float> all ((size_t) numFrames * (size_t) settings.numMels);
+    ASSERT_EQ(logMel.process (sine.data(), (int) sine.size(), all.data()), numFrames);
+
+    std::vector<float> single ((size_t) settings.numMels);
+    logMel.processFrame (sine.data() + 2 * settings.hopLength, single.data());
+
+    for (int m = 0; m < settings.numMels; ++m)
+        EXPECT_FLOAT_EQ(all[(size_t) (2 * settings.numMels + m)], single[(size_t) m]);
+}
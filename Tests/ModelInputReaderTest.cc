@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include "Analysis/ModelInputReader.h"
+
+static MemoryBlock makeWav (const std::vector<float>& samples)
+{
+    MemoryBlock data;
+    AudioBuffer<float> buffer (1, (int) samples.size());
+    buffer.copyFrom (0, 0, samples.data(), (int) samples.size());
+
+    {
+        std::unique_ptr<AudioFormatWriter> writer (WavAudioFormat().createWriterFor (new MemoryOutputStream (data, false),
+                                                                                      44100.0, 1, 24, {}, 0));
+        writer->writeFromAudioSampleBuffer (buffer, 0, buffer.getNumSamples());
+    }
+
+    return data;
+}
+
+static std::unique_ptr<AudioFormatReader> makeReader (const MemoryBlock& wav)
+{
+    return std::unique_ptr<AudioFormatReader> (WavAudioFormat().createReaderFor (new MemoryInputStream (wav, false), true));
+}
+
+static std::vector<float> makeNoise (int numSamples)
+{
+    std::vector<float> samples ((size_t) numSamples);
+    Random random (11);
+    for (auto& sample : samples)
+        sample = random.nextFloat() - 0.5f;
+    return samples;
+}
+
+///Reads at most maxBlocks blocks, like an analysis that stops once it has its windows
+static uint64 hashWhileReading (AudioFormatReader& reader, int maxBlocks)
+{
+    ModelInputReader input (4096);
+    input.reset (reader, 22050.0);
+
+    std::vector<float> block ((size_t) input.getMaxBlockSize());
+    int numSamples = 0;
+
+    for (int i = 0; i < maxBlocks && input.readNextBlock (block.data(), numSamples); ++i) {}
+
+    return input.getDecodedAudioHash().getHash();
+}
+
+TEST(ModelInputReader, HashesExactlyWhatItDecoded) {
+    auto samples = makeNoise (44100);
+    auto reader = makeReader (makeWav (samples));
+    auto copy = makeReader (makeWav (samples));
+
+    EXPECT_EQ(hashWhileReading (*reader, 1000), hashWhileReading (*copy, 1000));
+
+    ///Only the start was read, so only the start is identified
+    EXPECT_NE(hashWhileReading (*reader, 2), hashWhileReading (*reader, 1000));
+
+    samples[40000] += 0.25f;
+    auto changedEnd = makeReader (makeWav (samples));
+    EXPECT_EQ(hashWhileReading (*reader, 2), hashWhileReading (*changedEnd, 2));
+    EXPECT_NE(hashWhileReading (*reader, 1000), hashWhileReading (*changedEnd, 1000));
+}
+
+TEST(ModelInputReader, AnyDecodedSampleChangesTheHash) {
+    auto samples = makeNoise (44100);
+    auto original = makeReader (makeWav (samples));
+
+    ///Same length, format and ends, only the middle differs
+    auto changedMiddle = samples;
+    changedMiddle[20000] += 0.25f;
+    auto middle = makeReader (makeWav (changedMiddle));
+
+    EXPECT_NE(hashWhileReading (*original, 1000), hashWhileReading (*middle, 1000));
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include "DSP/ModulationCore.h"
+
+TEST(ModulationCore, CosineMatchesTheLibraryOne) {
+    for (float phase = -2.f; phase <= 2.f; phase += 0.001f)
+        EXPECT_NEAR(ModulationCore::cosine (phase), std::cos (MathConstants<float>::twoPi * phase), 1.0e-5f) << phase;
+}
+
+TEST(ModulationCore, FollowsEachLfoAcrossUnevenBlocks) {
+    constexpr double sampleRate = 44100.0;
+    ModulationCore core;
+    core.prepare (sampleRate, 512, 5);
+
+    ///Five LFOs, so the second group of four lanes is only partly used
+    const float rates[] = { 0.25f, 1.f, 5.f, 7.5f, 12.f };
+    const float startPhases[] = { 0.f, 0.25f, 0.5f, 0.9f, -0.3f };
+    for (int lfo = 0; lfo < 5; ++lfo)
+        EXPECT_EQ(core.addLfo (rates[lfo], startPhases[lfo]), lfo);
+
+    int elapsed = 0;
+    for (int numSamples : { 512, 100, 31, 1, 33, 512, 257 }) {
+        core.advance (numSamples);
+
+        for (int lfo = 0; lfo < 5; ++lfo) {
+            const auto* values = core.getValues (lfo);
+
+            for (int i = 0; i < numSamples; ++i) {
+                auto phase = startPhases[lfo] + rates[lfo] * (double) (elapsed + i + 1) / sampleRate;
+                auto expected = std::cos (MathConstants<double>::twoPi * phase);
+
+                ///Straight lines between points 32 samples apart, the error grows with the square of the rate
+                EXPECT_NEAR(values[i], expected, 5.0e-4) << lfo << " " << elapsed + i;
+            }
+        }
+
+        elapsed += numSamples;
+    }
+}
+
+TEST(ModulationCore, RateChangesAndResetsOnlyTouchTheirLfo) {
+    ModulationCore core;
+    core.prepare (48000.0, 256, 2);
+    auto first = core.addLfo (2.f, 0.f);
+    auto second = core.addLfo (2.f, 0.f);
+
+    core.advance (256);
+    core.setRate (second, 0.f);
+    core.resetPhase (second);
+    core.advance (256);
+
+    ///Stopped at the top of the cosine
+    for (int i = 0; i < 256; ++i)
+        EXPECT_FLOAT_EQ(core.getValues (second)[i], ModulationCore::cosine (0.f));
+
+    EXPECT_NEAR(core.getValues (first)[255], std::cos (MathConstants<double>::twoPi * 2.0 * 512.0 / 48000.0), 1.0e-4);
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include "Analysis/PolyphaseResampler.h"
+
+static std::vector<float> makeSine (double frequency, double sampleRate, int numSamples)
+{
+    std::vector<float> samples ((size_t) numSamples);
+    for (int i = 0; i < numSamples; ++i)
+        samples[(size_t) i] = (float) std::sin (2.0 * 3.14159265358979 * frequency * i / sampleRate);
+    return samples;
+}
+
+static std::vector<float> resample (PolyphaseResampler& resampler, const std::vector<float>& input, int chunkSize)
+{
+    std::vector<float> output;
+    std::vector<float> block ((size_t) resampler.getMaxNumOutputSamples (chunkSize));
+
+    for (size_t pos = 0; pos < input.size(); pos += (size_t) chunkSize)
+    {
+        auto num = (int) std::min<size_t> ((size_t) chunkSize, input.size() - pos);
+        auto numOut = resampler.process (input.data() + pos, num, block.data());
+        EXPECT_LE(numOut, (int) block.size());
+        output.insert (output.end(), block.begin(), block.begin() + numOut);
+    }
+
+    return output;
+}
+
+static double rms (const std::vector<float>& samples, size_t margin)
+{
+    double sum = 0.0;
+    for (size_t i = margin; i < samples.size() - margin; ++i)
+        sum += (double) samples[i] * samples[i];
+    return std::sqrt (sum / (double) (samples.size() - 2 * margin));
+}
+
+TEST(PolyphaseResampler, ReducesRatio) {
+    PolyphaseResampler resampler (48000.0, 22050.0);
+    EXPECT_EQ(resampler.getUpFactor(), 147);
+    EXPECT_EQ(resampler.getDownFactor(), 320);
+}
+
+TEST(PolyphaseResampler, DoesNotDependOnChunking) {
+    auto input = makeSine (440.0, 48000.0, 20000);
+
+    PolyphaseResampler whole (48000.0, 22050.0);
+    PolyphaseResampler chunked (48000.0, 22050.0);
+    auto expected = resample (whole, input, (int) input.size());
+    auto actual = resample (chunked, input, 777);
+
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+        EXPECT_FLOAT_EQ(expected[i], actual[i]);
+}
+
+TEST(PolyphaseResampler, KeepsPassbandAndRemovesAliases) {
+    PolyphaseResampler passband (44100.0, 22050.0);
+    auto low = resample (passband, makeSine (1000.0, 44100.0, 44100), 4096);
+    EXPECT_NEAR(rms (low, 256), std::sqrt (0.5), 0.01);
+
+    PolyphaseResampler stopband (44100.0, 22050.0);
+    auto high = resample (stopband, makeSine (15000.0, 44100.0, 44100), 4096);
+    EXPECT_LT(rms (high, 256), 0.001);
+}
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+
+#include "ProcessingChain.h"
+
+///Graph chains are built on the message thread, which is the test thread here
+static std::unique_ptr<ProcessingChain> makeChain (const Array<EffectEnum>& effects,
+                                                   ProcessingChain::Engine engine = ProcessingChain::Engine::flat)
+{
+    return std::make_unique<ProcessingChain> (effects, 2, 44100.0, 512, engine);
+}
+
+static AudioBuffer<float> processNoise (ProcessingChain& chain)
+{
+    AudioBuffer<float> buffer (2, 512);
+    Random random (3);
+
+    for (int channel = 0; channel < 2; ++channel)
+        for (int i = 0; i < 512; ++i)
+            buffer.setSample (channel, i, random.nextFloat() - 0.5f);
+
+    MidiBuffer midi;
+    chain.process (buffer, midi);
+    return buffer;
+}
+
+TEST(ProcessingChain, EmptyChainPassesAudioThrough) {
+    ScopedJuceInitialiser_GUI juceInitialiser;
+
+    for (auto engine : { ProcessingChain::Engine::flat, ProcessingChain::Engine::graph }) {
+        auto chain = makeChain ({}, engine);
+
+        AudioBuffer<float> buffer (2, 512);
+        FloatVectorOperations::fill (buffer.getWritePointer (0), 0.25f, 512);
+        FloatVectorOperations::fill (buffer.getWritePointer (1), -0.5f, 512);
+        MidiBuffer midi;
+
+        chain->process (buffer, midi);
+
+        EXPECT_FLOAT_EQ(buffer.getSample (0, 100), 0.25f);
+        EXPECT_FLOAT_EQ(buffer.getSample (1, 511), -0.5f);
+    }
+}
+
+TEST(ProcessingChain, DryChainPassesAudioThrough) {
+    ScopedJuceInitialiser_GUI juceInitialiser;
+
+    for (auto engine : { ProcessingChain::Engine::flat, ProcessingChain::Engine::graph }) {
+        auto chain = makeChain ({ EffectEnum::Dry }, engine);
+        EXPECT_EQ(chain->getNumEffects(), 1);
+        EXPECT_EQ(chain->getEffectProcessor (0), nullptr);
+
+        AudioBuffer<float> buffer (2, 512);
+        Random random (5);
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = 0; i < 512; ++i)
+                buffer.setSample (channel, i, random.nextFloat() - 0.5f);
+
+        AudioBuffer<float> input (buffer);
+        MidiBuffer midi;
+        chain->process (buffer, midi);
+
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = 0; i < 512; ++i)
+                ASSERT_FLOAT_EQ(buffer.getSample (channel, i), input.getSample (channel, i)) << channel << " " << i;
+    }
+}
+
+TEST(ProcessingChain, FlatAndGraphEnginesSoundTheSame) {
+    ScopedJuceInitialiser_GUI juceInitialiser;
+
+    Array<EffectEnum> effects { EffectEnum::Chorus, EffectEnum::Chorus, EffectEnum::Chorus };
+    auto flat = processNoise (*makeChain (effects, ProcessingChain::Engine::flat));
+    auto graph = processNoise (*makeChain (effects, ProcessingChain::Engine::graph));
+
+    for (int channel = 0; channel < 2; ++channel)
+        for (int i = 0; i < 512; ++i)
+            ASSERT_NEAR(flat.getSample (channel, i), graph.getSample (channel, i), 1.0e-6f);
+}
+
+TEST(ProcessingChain, OnlyProcessesTheSettingsItWasPreparedFor) {
+    ScopedJuceInitialiser_GUI juceInitialiser;
+    auto chain = makeChain ({ EffectEnum::Chorus });
+
+    EXPECT_EQ(chain->getNumEffects(), 1);
+    EXPECT_NE(chain->getEffectProcessor (0), nullptr);
+    EXPECT_EQ(chain->getEffectProcessor (1), nullptr);
+
+    EXPECT_TRUE(chain->canProcess (512, 44100.0));
+    EXPECT_TRUE(chain->canProcess (64, 44100.0));
+    EXPECT_FALSE(chain->canProcess (1024, 44100.0));
+    EXPECT_FALSE(chain->canProcess (512, 48000.0));
+}
+
+TEST(ProcessingChain, ReportsTheLatencyOfItsEffects) {
+    Array<EffectEnum> effects { EffectEnum::Reverb, EffectEnum::Distortion, EffectEnum::Overdrive };
+    EXPECT_EQ(makeChain (effects)->getLatencySamples(), 0);
+
+    auto chain = std::make_unique<ProcessingChain> (effects, 2, 44100.0, 512, ProcessingChain::Engine::flat, 4);
+    auto distortionLatency = chain->getEffectProcessor (1)->getLatencySamples();
+    EXPECT_GT(distortionLatency, 0);
+    EXPECT_EQ(chain->getLatencySamples(), distortionLatency + chain->getEffectProcessor (2)->getLatencySamples());
+}
+
+TEST(ProcessingChain, ModulationEffectsSoundTheSameOnTheSharedCore) {
+    Array<EffectEnum> effects { EffectEnum::Flanger, EffectEnum::Phaser, EffectEnum::Tremolo, EffectEnum::Vibrato };
+    auto chain = makeChain (effects);
+
+    ///The same effects alone, each advancing a core of its own
+    std::vector<std::unique_ptr<AudioProcessor>> separateEffects;
+    for (auto effect : effects) {
+        separateEffects.push_back (createEffectProcessor (effect));
+        separateEffects.back()->setPlayConfigDetails (2, 2, 44100.0, 512);
+        separateEffects.back()->prepareToPlay (44100.0, 512);
+    }
+
+    Random random (7);
+    MidiBuffer midi;
+
+    ///Uneven blocks, the LFOs must stay in step across them
+    for (int numSamples : { 512, 300, 17, 512 }) {
+        AudioBuffer<float> shared (2, numSamples);
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                shared.setSample (channel, i, random.nextFloat() - 0.5f);
+
+        AudioBuffer<float> separate (shared);
+        chain->process (shared, midi);
+        for (auto& processor : separateEffects)
+            processor->processBlock (separate, midi);
+
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                ASSERT_FLOAT_EQ(shared.getSample (channel, i), separate.getSample (channel, i)) << numSamples << " " << i;
+    }
+}
+
+TEST(ProcessingChain, DelayTailsFollowTheFeedbackActuallyPlayed) {
+    FeedBackDelayProcessor delay;
+
+    for (auto feedback : { 1.f, 1.5f, 50.f }) {
+        delay.setFeedback (feedback);
+        EXPECT_FLOAT_EQ(delay.getFeedback(), StereoDelayLine::maximumFeedback);
+
+        auto tail = delay.getTailLengthSeconds();
+        EXPECT_TRUE(std::isfinite (tail));
+        EXPECT_GT(tail, delay.getTime());
+    }
+
+    delay.setFeedback (-0.5f);
+    EXPECT_DOUBLE_EQ(delay.getTailLengthSeconds(), delay.getTime());
+}
+
+TEST(ChainExchange, AudioThreadTakesTheLatestPublishedChain) {
+    ScopedJuceInitialiser_GUI juceInitialiser;
+    ChainExchange exchange;
+
+    EXPECT_EQ(exchange.getChainForAudioThread(), nullptr);
+
+    auto first = makeChain ({});
+    auto* firstChain = first.get();
+    exchange.publish (std::move (first));
+
+    EXPECT_EQ(exchange.getLatest(), firstChain);
+    EXPECT_EQ(exchange.getChainForAudioThread(), firstChain);
+    EXPECT_EQ(exchange.getChainForAudioThread(), firstChain);
+
+    ///Published twice between two blocks, the first one is dropped without ever reaching the audio thread
+    exchange.publish (makeChain ({ EffectEnum::Chorus }));
+    auto third = makeChain ({ EffectEnum::Chorus, EffectEnum::Chorus });
+    auto* thirdChain = third.get();
+    exchange.publish (std::move (third));
+
+    EXPECT_EQ(exchange.getLatest(), thirdChain);
+    EXPECT_EQ(exchange.getChainForAudioThread(), thirdChain);
+    EXPECT_EQ(exchange.getChainForAudioThread()->getNumEffects(), 2);
+}
+
+TEST(ChainExchange, EveryPublishFreesTheRetiredSlot) {
+    ScopedJuceInitialiser_GUI juceInitialiser;
+    ChainExchange exchange;
+
+    exchange.publish (makeChain ({}));
+    auto* firstChain = exchange.getChainForAudioThread();
+
+    exchange.publish (makeChain ({ EffectEnum::Chorus }));
+    auto* secondChain = exchange.getChainForAudioThread();
+    EXPECT_NE(secondChain, firstChain);
+
+    ///The first chain sits in the retired slot, the next publish deletes it so the third one can go live
+    auto third = makeChain ({});
+    auto* thirdChain = third.get();
+    exchange.publish (std::move (third));
+
+    EXPECT_EQ(exchange.getChainForAudioThread(), thirdChain);
+}
@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+
+#include "Analysis/SharedClassifier.h"
+#include "Analysis/AnalysisTypes.h"
+
+namespace
+{
+    String makeMetadata (int formatVersion, int numClasses)
+    {
+        DynamicObject::Ptr metadata (new DynamicObject());
+        metadata->setProperty ("formatVersion", formatVersion);
+        metadata->setProperty ("numClasses", numClasses);
+        metadata->setProperty ("sampleRate", 22050);
+        return JSON::toString (var (metadata.get()));
+    }
+}
+
+TEST(SharedClassifier, AcceptsMetadataOfTheSupportedVersion) {
+    EXPECT_TRUE(SharedClassifier::checkModelMetadata (makeMetadata (SharedClassifier::supportedModelFormatVersion, numberOfEffects)).isEmpty());
+}
+
+TEST(SharedClassifier, RejectsMissingOrMismatchingMetadata) {
+    EXPECT_FALSE(SharedClassifier::checkModelMetadata ({}).isEmpty());
+    EXPECT_FALSE(SharedClassifier::checkModelMetadata ("not json").isEmpty());
+    EXPECT_FALSE(SharedClassifier::checkModelMetadata (makeMetadata (SharedClassifier::supportedModelFormatVersion + 1, numberOfEffects)).isEmpty());
+    EXPECT_FALSE(SharedClassifier::checkModelMetadata (makeMetadata (SharedClassifier::supportedModelFormatVersion, numberOfEffects - 1)).isEmpty());
+}
+
+TEST(SharedClassifier, ExternalModelFilesLiveInTheModelDirectory) {
+    auto previous = SharedClassifier::getModelDirectory();
+    auto folder = File::getSpecialLocation (File::tempDirectory).getChildFile ("AutoEffectModelsTest");
+    SharedClassifier::setModelDirectory (folder);
+
+    ///classifier.pt with libtorch, classifier.aenet without
+    auto fp32File = SharedClassifier::getExternalModelFile (ModelVariant::Float32);
+    EXPECT_EQ(fp32File.getParentDirectory(), folder);
+    EXPECT_EQ(fp32File.getFileNameWithoutExtension(), "classifier");
+    EXPECT_EQ(SharedClassifier::getExternalModelFile (ModelVariant::Int8), folder.getChildFile ("classifier_int8.pt"));
+
+    SharedClassifier::setModelDirectory (previous);
+}
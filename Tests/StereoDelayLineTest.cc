@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include "DSP/StereoDelayLine.h"
+
+///A rate where one sample is one millisecond keeps the expected positions readable
+static constexpr double testRate = 1000.0;
+
+TEST(StereoDelayLine, RepeatsEachChannelAfterTheDelay) {
+    StereoDelayLine delay;
+    delay.setDelaySeconds (0.01f);
+    delay.setFeedback (0.5f);
+    delay.setMix (1.f);
+    delay.prepare (testRate, 0.05);
+
+    std::vector<float> left (64, 0.f), right (64, 0.f);
+    left[0] = 1.f;
+    right[0] = -1.f;
+
+    delay.process (left.data(), right.data(), 64);
+
+    for (int i = 0; i < 64; ++i) {
+        auto expected = i > 0 && i % 10 == 0 ? std::pow (0.5f, (float) (i / 10 - 1)) : 0.f;
+        EXPECT_FLOAT_EQ(left[(size_t) i], expected) << i;
+        EXPECT_FLOAT_EQ(right[(size_t) i], -expected) << i;
+    }
+}
+
+TEST(StereoDelayLine, InterpolatesFractionalDelays) {
+    StereoDelayLine delay;
+    delay.setDelaySeconds (0.0105f);
+    delay.setMix (1.f);
+    delay.prepare (testRate, 0.05);
+
+    ///Mono buffers pass the same pointer twice
+    std::vector<float> samples (32, 0.f);
+    samples[0] = 1.f;
+    delay.process (samples.data(), samples.data(), 32);
+
+    EXPECT_FLOAT_EQ(samples[10], 0.5f);
+    EXPECT_FLOAT_EQ(samples[11], 0.5f);
+    EXPECT_FLOAT_EQ(samples[12], 0.f);
+}
+
+TEST(StereoDelayLine, WrapsAroundAndGlidesWithoutReallocating) {
+    StereoDelayLine delay;
+    delay.setMix (1.f);
+    delay.setDelaySeconds (0.02f);
+    delay.prepare (testRate, 0.05);
+
+    auto capacity = delay.getCapacity();
+    EXPECT_EQ(capacity, 64);
+
+    ///Several laps of the buffer, an impulse every 40 samples must come back 20 samples later every time
+    std::vector<float> left (400, 0.f), right (400, 0.f);
+    for (size_t i = 0; i < left.size(); i += 40)
+        left[i] = right[i] = 1.f;
+
+    delay.process (left.data(), right.data(), (int) left.size());
+
+    for (size_t i = 0; i < left.size(); ++i)
+        EXPECT_FLOAT_EQ(left[i], i % 40 == 20 ? 1.f : 0.f) << i;
+
+    ///Longer than the buffer allows: clamped, and still the same buffer
+    delay.setDelaySeconds (10.f);
+    EXPECT_EQ(delay.getCapacity(), capacity);
+    EXPECT_LE(delay.getDelaySamples(), (float) capacity);
+}
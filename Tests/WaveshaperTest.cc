@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include "EffectProcessors.h"
+
+TEST(Waveshaper, CurvesAreOddBoundedAndFlatAtTheClamp) {
+    for (auto curve : { Waveshaper::Curve::cubic, Waveshaper::Curve::quintic }) {
+        EXPECT_FLOAT_EQ(Waveshaper::shape (0.f, curve), 0.f);
+        EXPECT_FLOAT_EQ(Waveshaper::shape (1.f, curve), 1.f);
+        EXPECT_FLOAT_EQ(Waveshaper::shape (5.f, curve), 1.f);
+        EXPECT_FLOAT_EQ(Waveshaper::shape (-0.3f, curve), -Waveshaper::shape (0.3f, curve));
+
+        ///No corner: just below the clamp is already almost at the ceiling
+        EXPECT_NEAR(Waveshaper::shape (0.99f, curve), 1.f, 1.0e-3f);
+
+        float previous = -1.f;
+        for (float x = -1.f; x <= 1.f; x += 0.01f) {
+            auto y = Waveshaper::shape (x, curve);
+            EXPECT_GE(y, previous - 1.0e-6f) << x;
+            previous = y;
+        }
+    }
+}
+
+TEST(Waveshaper, VectorLoopMatchesTheScalarCurve) {
+    ///Not a multiple of 4, so both the vector loop and the scalar tail run
+    std::vector<float> input;
+    for (int i = 0; i < 103; ++i)
+        input.push_back (std::sin ((float) i * 0.37f) * 1.3f);
+
+    for (auto curve : { Waveshaper::Curve::cubic, Waveshaper::Curve::quintic }) {
+        auto samples = input;
+        Waveshaper::process (samples.data(), (int) samples.size(), curve, 2.5f, 0.7f);
+
+        for (size_t i = 0; i < input.size(); ++i)
+            EXPECT_NEAR(samples[i], 0.7f * Waveshaper::shape (2.5f * input[i], curve), 1.0e-6f) << i;
+    }
+}
+
+TEST(Waveshaper, LatencyGrowsWithTheOversamplingFactor) {
+    DistortionProcessor distortion;
+    distortion.setPlayConfigDetails (2, 2, 48000.0, 256);
+    distortion.prepareToPlay (48000.0, 256);
+    EXPECT_EQ(distortion.getLatencySamples(), 0);
+
+    int previousLatency = 0;
+    for (int factor = 2; factor <= WaveshaperProcessor::maximumOversamplingFactor; factor *= 2) {
+        distortion.setOversamplingFactor (factor);
+        EXPECT_EQ(distortion.getOversamplingFactor(), factor);
+        EXPECT_GT(distortion.getLatencySamples(), previousLatency) << factor;
+        previousLatency = distortion.getLatencySamples();
+    }
+
+    ///Factors in between are rounded down
+    distortion.setOversamplingFactor (6);
+    EXPECT_EQ(distortion.getOversamplingFactor(), 4);
+
+    distortion.setOversamplingFactor (1);
+    EXPECT_EQ(distortion.getLatencySamples(), 0);
+}